@@ -0,0 +1,83 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Benchmarks of the container combinators with hardware counters, e.g.
+ * `list` pointer chasing versus `vector` streaming in `fmap`.
+ *
+ * Usage: combinator-bench [elements]
+ */
+
+#include <algebra/data/foldable.hpp>
+#include <algebra/data/stl_container.hpp>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <list>
+#include <numeric>
+#include <utility>
+#include <vector>
+#include "perf_counters.hpp"
+
+using namespace algebra;
+
+template <typename C>
+C iota_of(std::size_t n) {
+    C c(n);
+    std::iota(c.begin(), c.end(), 0);
+    return c;
+}
+
+template <typename C>
+void container_cases(bench::perf_counters &pc, std::vector<bench::result> &results,
+                     const std::string &name, std::size_t n) {
+    const C xs = iota_of<C>(n);
+    const C half = iota_of<C>(n / 2);
+    auto inc = [](int x) { return x + 1; };
+    auto pair = [](int x) { return C{x, x}; };
+    auto sum_of = [](int x) { return sum<long>(x); };
+
+    results.push_back(bench::run(pc, name + " fmap", n, [&] {
+        auto r = functor<C>::fmap(inc, xs);
+        bench::do_not_optimize(r);
+    }));
+    results.push_back(bench::run(pc, name + " fmap (rvalue, in place)", n, [&] { return xs; },
+                                 [&](C &&ys) {
+                                     auto r = functor<C>::fmap(inc, std::move(ys));
+                                     bench::do_not_optimize(r);
+                                 }));
+    results.push_back(bench::run(pc, name + " bind", n, [&] {
+        auto r = monad<C>::bind(half, pair);
+        bench::do_not_optimize(r);
+    }));
+    results.push_back(bench::run(pc, name + " mappend", n, [&] {
+        auto r = monoid<C>::mappend(half, half);
+        bench::do_not_optimize(r);
+    }));
+    results.push_back(bench::run(pc, name + " foldMap", n, [&] {
+        auto r = foldMap(sum_of, xs);
+        bench::do_not_optimize(r);
+    }));
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : std::size_t(1) << 20;
+    if (n < 2) {
+        n = 2;
+    }
+
+    bench::perf_counters pc;
+    if (!pc.any_available()) {
+        std::cerr << "hardware counters unavailable, reporting wall-clock time only\n";
+    }
+
+    std::vector<bench::result> results;
+    container_cases<std::vector<int>>(pc, results, "vector", n);
+    container_cases<std::deque<int>>(pc, results, "deque", n);
+    container_cases<std::list<int>>(pc, results, "list", n);
+
+    std::cout << n << " elements\n";
+    bench::report(std::cout, results);
+    return 0;
+}
@@ -0,0 +1,269 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_BENCH_PERF_COUNTERS_HPP__
+#define __ALGEBRA_BENCH_PERF_COUNTERS_HPP__
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Benchmark harness reading hardware performance counters (Linux
+ * `perf_event_open`) around each case: cycles, instructions, L1 data cache
+ * misses, last level cache misses, branch misses and page faults.
+ *
+ * Counters that can't be opened (other systems, virtual machines without a
+ * PMU, `perf_event_paranoid` too restrictive) are reported as "-", and only
+ * the wall-clock time is measured.
+ */
+namespace bench {
+
+    enum counter { cycles, instructions, l1d_misses, llc_misses, branch_misses, page_faults };
+
+    constexpr int counter_count = 6;
+
+    // Per-thread counters of the calling thread.
+    class perf_counters {
+        int fds_[counter_count];
+
+#if defined(__linux__)
+        static int open_counter(std::uint32_t type, std::uint64_t config) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = 1;
+            attr.exclude_kernel = type == PERF_TYPE_SOFTWARE ? 0 : 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(::syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+
+       public:
+        perf_counters() {
+#if defined(__linux__)
+            const std::uint64_t l1d_read_miss = PERF_COUNT_HW_CACHE_L1D |
+                                                (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            fds_[cycles] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+            fds_[instructions] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+            fds_[l1d_misses] = open_counter(PERF_TYPE_HW_CACHE, l1d_read_miss);
+            fds_[llc_misses] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+            fds_[branch_misses] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+            fds_[page_faults] = open_counter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+#else
+            for (auto &fd : fds_) {
+                fd = -1;
+            }
+#endif
+        }
+
+        perf_counters(const perf_counters &) = delete;
+        perf_counters &operator=(const perf_counters &) = delete;
+
+        ~perf_counters() {
+#if defined(__linux__)
+            for (int fd : fds_) {
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+            }
+#endif
+        }
+
+        bool available(counter c) const { return fds_[c] >= 0; }
+
+        bool any_available() const {
+            for (int fd : fds_) {
+                if (fd >= 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void start() {
+#if defined(__linux__)
+            for (int fd : fds_) {
+                if (fd >= 0) {
+                    ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                    ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+                }
+            }
+#endif
+        }
+
+        // Count again after `stop`, from the counts so far.
+        void resume() {
+#if defined(__linux__)
+            for (int fd : fds_) {
+                if (fd >= 0) {
+                    ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+                }
+            }
+#endif
+        }
+
+        void stop() {
+#if defined(__linux__)
+            for (int fd : fds_) {
+                if (fd >= 0) {
+                    ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+                }
+            }
+#endif
+        }
+
+        // The count since `start`, scaled up when the counter was multiplexed,
+        // or -1 when unavailable.
+        double read(counter c) const {
+#if defined(__linux__)
+            std::uint64_t values[3];
+            if (fds_[c] < 0 || ::read(fds_[c], values, sizeof(values)) != sizeof(values) ||
+                values[2] == 0) {
+                return -1;
+            }
+            return double(values[0]) * double(values[1]) / double(values[2]);
+#else
+            (void)c;
+            return -1;
+#endif
+        }
+    };
+
+    // Keep the compiler from optimizing away a value.
+    template <typename T>
+    inline void do_not_optimize(const T &value) {
+#if defined(__GNUC__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static volatile const void *sink;
+        sink = &value;
+#endif
+    }
+
+    struct result {
+        std::string name;
+        std::size_t elements;
+        std::size_t iterations;
+        double ns;
+        double counts[counter_count];
+    };
+
+    // Run `fn` (a case processing `elements` elements) repeatedly for at least
+    // `min_seconds`, after a warm-up run, and give the averages per run.
+    template <typename Fn>
+    result run(perf_counters &pc, const std::string &name, std::size_t elements, Fn &&fn,
+               double min_seconds = 0.2) {
+        fn();
+        std::size_t iterations = 1;
+        for (;;) {
+            pc.start();
+            auto begin = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < iterations; ++i) {
+                fn();
+            }
+            auto end = std::chrono::steady_clock::now();
+            pc.stop();
+            double seconds = std::chrono::duration<double>(end - begin).count();
+            if (seconds >= min_seconds || iterations >= (std::size_t(1) << 30)) {
+                result r{name, elements, iterations, seconds * 1e9 / double(iterations), {}};
+                for (int c = 0; c < counter_count; ++c) {
+                    double v = pc.read(counter(c));
+                    r.counts[c] = v < 0 ? v : v / double(iterations);
+                }
+                return r;
+            }
+            iterations *= 2;
+        }
+    }
+
+    // Run `fn` on a fresh input from `make` like `run`, for the cases that
+    // consume their input: the inputs are made outside of the timed region
+    // and of the counters.
+    template <typename Make, typename Fn>
+    result run(perf_counters &pc, const std::string &name, std::size_t elements, Make &&make,
+               Fn &&fn, double min_seconds = 0.2) {
+        fn(make());
+        std::size_t iterations = 1;
+        for (;;) {
+            pc.start();
+            pc.stop();
+            double seconds = 0;
+            for (std::size_t i = 0; i < iterations; ++i) {
+                auto input = make();
+                pc.resume();
+                auto begin = std::chrono::steady_clock::now();
+                fn(std::move(input));
+                auto end = std::chrono::steady_clock::now();
+                pc.stop();
+                seconds += std::chrono::duration<double>(end - begin).count();
+            }
+            if (seconds >= min_seconds || iterations >= (std::size_t(1) << 30)) {
+                result r{name, elements, iterations, seconds * 1e9 / double(iterations), {}};
+                for (int c = 0; c < counter_count; ++c) {
+                    double v = pc.read(counter(c));
+                    r.counts[c] = v < 0 ? v : v / double(iterations);
+                }
+                return r;
+            }
+            iterations *= 2;
+        }
+    }
+
+    // Print a table of results: time, IPC and events per element.
+    inline void report(std::ostream &out, const std::vector<result> &results) {
+        auto per_element = [&](const result &r, counter c) {
+            std::ostringstream s;
+            if (r.counts[c] < 0) {
+                s << "-";
+            } else {
+                s << std::fixed << std::setprecision(3) << r.counts[c] / double(r.elements);
+            }
+            return s.str();
+        };
+        out << std::left << std::setw(32) << "case" << std::right << std::setw(10) << "ns/elem"
+            << std::setw(8) << "IPC" << std::setw(11) << "cyc/elem" << std::setw(11) << "L1D/elem"
+            << std::setw(11) << "LLC/elem" << std::setw(11) << "br/elem" << std::setw(11)
+            << "faults/run" << "\n";
+        for (auto &r : results) {
+            std::ostringstream ipc;
+            if (r.counts[cycles] > 0 && r.counts[instructions] >= 0) {
+                ipc << std::fixed << std::setprecision(2)
+                    << r.counts[instructions] / r.counts[cycles];
+            } else {
+                ipc << "-";
+            }
+            std::ostringstream faults;
+            if (r.counts[page_faults] < 0) {
+                faults << "-";
+            } else {
+                faults << std::fixed << std::setprecision(1) << r.counts[page_faults];
+            }
+            out << std::left << std::setw(32) << r.name << std::right << std::fixed
+                << std::setprecision(3) << std::setw(10) << r.ns / double(r.elements)
+                << std::setw(8) << ipc.str() << std::setw(11) << per_element(r, cycles)
+                << std::setw(11) << per_element(r, l1d_misses) << std::setw(11)
+                << per_element(r, llc_misses) << std::setw(11) << per_element(r, branch_misses)
+                << std::setw(11) << faults.str() << "\n";
+        }
+    }
+};
+
+#endif /* __ALGEBRA_BENCH_PERF_COUNTERS_HPP__ */
@@ -5,6 +5,7 @@
 #include <algebra/control/applicative.hpp>
 #include <algebra/control/functor.hpp>
 #include <algebra/control/monad.hpp>
+#include <algebra/data/function.hpp>
 #include <algebra/data/stl_container.hpp>
 #include <functional>
 #include <iostream>
@@ -34,8 +35,8 @@ void applicative_demo() {
     std::cout << "length of pure container: " << pure_container.size()
               << std::endl;
 
-    std::list<std::function<int(int)>> fs{[](int x) { return x - 1; },
-                                          [](int x) { return x + 1; }};
+    std::list<algebra::inplace_function<int(int)>> fs{[](int x) { return x - 1; },
+                                                      [](int x) { return x + 1; }};
 
     using algebra::operator*;
     // auto r = algebra::applicative<std::list<int>>::ap(
@@ -0,0 +1,231 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_BASIC_INSTRUMENT_HPP__
+#define __ALGEBRA_BASIC_INSTRUMENT_HPP__
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Instrumentation of the container instances: counts of element copies,
+ * element moves, allocations and allocated bytes, broken down by combinator.
+ *
+ * Define `ALGEBRA_INSTRUMENT` before including any header of the library to
+ * enable it. Then every call of `fmap`, `bind`, `ap`, `mappend` and `join` on a
+ * container opens a scope, and the events that happen in the scope are added
+ * to the counters of that combinator. A combinator called by another one (e.g.
+ * `fmap` by `bind`) is accounted to the outer one. Without the macro the scopes
+ * compile to nothing.
+ *
+ * Events are recorded by the element wrapper `counted<T>` and by the allocator
+ * `counting_allocator<T>`, e.g.:
+ *
+ *      #define ALGEBRA_INSTRUMENT
+ *      using elem = instrument::counted<int>;
+ *      std::vector<elem, instrument::counting_allocator<elem>> xs = ...;
+ *      instrument::reset();
+ *      auto ys = f % xs;
+ *      auto fmap_copies = instrument::take()[instrument::combinator::fmap].copies;
+ *
+ * Counters are global and atomic, the current combinator is per thread.
+ */
+namespace algebra {
+    namespace instrument {
+
+        enum class combinator : int { none, fmap, bind, ap, mappend, join };
+
+        constexpr std::size_t combinator_count = 6;
+
+        struct counters {
+            std::size_t calls = 0;
+            std::size_t allocations = 0;
+            std::size_t bytes = 0;
+            std::size_t copies = 0;
+            std::size_t moves = 0;
+        };
+
+        // A copy of the counters at some point, indexed by combinator.
+        struct snapshot {
+            counters of[combinator_count];
+
+            const counters &operator[](combinator c) const { return of[static_cast<int>(c)]; }
+
+            // The sum of all combinators, including the events out of any scope.
+            counters total() const {
+                counters t;
+                for (auto &c : of) {
+                    t.calls += c.calls;
+                    t.allocations += c.allocations;
+                    t.bytes += c.bytes;
+                    t.copies += c.copies;
+                    t.moves += c.moves;
+                }
+                return t;
+            }
+        };
+
+        namespace _inner_impl {
+            struct atomic_counters {
+                std::atomic<std::size_t> calls{0}, allocations{0}, bytes{0}, copies{0}, moves{0};
+            };
+
+            inline atomic_counters *table() {
+                static atomic_counters t[combinator_count];
+                return t;
+            }
+
+            inline combinator &current() {
+                thread_local combinator c = combinator::none;
+                return c;
+            }
+
+            inline atomic_counters &active() { return table()[static_cast<int>(current())]; }
+        };
+
+        inline snapshot take() {
+            snapshot s;
+            for (std::size_t i = 0; i < combinator_count; ++i) {
+                auto &c = _inner_impl::table()[i];
+                s.of[i].calls = c.calls.load(std::memory_order_relaxed);
+                s.of[i].allocations = c.allocations.load(std::memory_order_relaxed);
+                s.of[i].bytes = c.bytes.load(std::memory_order_relaxed);
+                s.of[i].copies = c.copies.load(std::memory_order_relaxed);
+                s.of[i].moves = c.moves.load(std::memory_order_relaxed);
+            }
+            return s;
+        }
+
+        inline void reset() {
+            for (std::size_t i = 0; i < combinator_count; ++i) {
+                auto &c = _inner_impl::table()[i];
+                c.calls.store(0, std::memory_order_relaxed);
+                c.allocations.store(0, std::memory_order_relaxed);
+                c.bytes.store(0, std::memory_order_relaxed);
+                c.copies.store(0, std::memory_order_relaxed);
+                c.moves.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        inline void record_copy() {
+            _inner_impl::active().copies.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        inline void record_move() {
+            _inner_impl::active().moves.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        inline void record_allocation(std::size_t bytes) {
+            auto &c = _inner_impl::active();
+            c.allocations.fetch_add(1, std::memory_order_relaxed);
+            c.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        // Account the events on this thread to `c` until the end of the scope,
+        // unless a combinator is already being accounted.
+        class scope {
+            bool outer_;
+
+           public:
+            explicit scope(combinator c) : outer_(_inner_impl::current() == combinator::none) {
+                if (outer_) {
+                    _inner_impl::current() = c;
+                    _inner_impl::active().calls.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+
+            scope(const scope &) = delete;
+            scope &operator=(const scope &) = delete;
+
+            ~scope() {
+                if (outer_) {
+                    _inner_impl::current() = combinator::none;
+                }
+            }
+        };
+
+        // Element wrapper that records its copies and moves. Conversions from
+        // and to `T` are not recorded.
+        template <typename T>
+        class counted {
+            T value_;
+
+           public:
+            using value_type = T;
+
+            counted() : value_() {}
+            counted(const T &value) : value_(value) {}
+            counted(T &&value) : value_(std::move(value)) {}
+
+            counted(const counted &other) : value_(other.value_) { record_copy(); }
+            counted(counted &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+                    : value_(std::move(other.value_)) {
+                record_move();
+            }
+
+            counted &operator=(const counted &other) {
+                value_ = other.value_;
+                record_copy();
+                return *this;
+            }
+
+            counted &operator=(counted &&other) noexcept(
+                    std::is_nothrow_move_assignable<T>::value) {
+                value_ = std::move(other.value_);
+                record_move();
+                return *this;
+            }
+
+            const T &value() const noexcept { return value_; }
+            T &value() noexcept { return value_; }
+
+            friend bool operator==(const counted &a, const counted &b) {
+                return a.value_ == b.value_;
+            }
+            friend bool operator!=(const counted &a, const counted &b) { return !(a == b); }
+            friend bool operator<(const counted &a, const counted &b) {
+                return a.value_ < b.value_;
+            }
+        };
+
+        // Allocator that records its allocations.
+        template <typename T>
+        struct counting_allocator {
+            using value_type = T;
+
+            counting_allocator() noexcept = default;
+            template <typename U>
+            counting_allocator(const counting_allocator<U> &) noexcept {}
+
+            T *allocate(std::size_t n) {
+                record_allocation(n * sizeof(T));
+                return std::allocator<T>().allocate(n);
+            }
+
+            void deallocate(T *p, std::size_t n) noexcept { std::allocator<T>().deallocate(p, n); }
+
+            template <typename U>
+            friend bool operator==(const counting_allocator &, const counting_allocator<U> &) {
+                return true;
+            }
+            template <typename U>
+            friend bool operator!=(const counting_allocator &, const counting_allocator<U> &) {
+                return false;
+            }
+        };
+    };
+};
+
+#ifdef ALGEBRA_INSTRUMENT
+#define ALGEBRA_INSTRUMENT_SCOPE(name) \
+    ::algebra::instrument::scope _algebra_instrument_scope(::algebra::instrument::combinator::name)
+#else
+#define ALGEBRA_INSTRUMENT_SCOPE(name) ((void)0)
+#endif
+
+#endif /* __ALGEBRA_BASIC_INSTRUMENT_HPP__ */
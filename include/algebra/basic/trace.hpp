@@ -0,0 +1,339 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_BASIC_TRACE_HPP__
+#define __ALGEBRA_BASIC_TRACE_HPP__
+
+#ifdef ALGEBRA_TRACE
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+#endif
+
+/**
+ * Timing spans of the combinator operators `%`, `*`, `>>=` and `^`, written as
+ * Chrome trace / Perfetto JSON (open the file in `chrome://tracing` or
+ * `ui.perfetto.dev`).
+ *
+ * Tracing is compiled in only when `ALGEBRA_TRACE` is defined before including
+ * the library, otherwise this header only declares `traced`, which calls the
+ * combinator directly, and the functions below don't exist. When
+ * compiled in, it is enabled at runtime by `trace::enable()`, or from the start
+ * by setting the environment variable `ALGEBRA_TRACE=1`; a disabled trace
+ * costs one relaxed load per operator.
+ *
+ * Every span records the combinator, the argument and result types, the
+ * argument and result sizes (for containers), the duration and the thread.
+ * Spans are written without locking into a ring buffer owned by the thread,
+ * the oldest spans are overwritten when it is full. Flush the buffers with
+ * `trace::write_json`, spans overwritten while they're written out are
+ * skipped. The buffers of exited threads are reused by new threads once
+ * flushed (or cleared), e.g.:
+ *
+ *      algebra::trace::enable();
+ *      run_pipeline();
+ *      std::ofstream out("pipeline.json");
+ *      algebra::trace::write_json(out);
+ */
+namespace algebra {
+    namespace trace {
+#ifdef ALGEBRA_TRACE
+
+        struct span {
+            const char *name;
+            const std::type_info *input;
+            const std::type_info *output;
+            std::size_t input_size;
+            std::size_t output_size;
+            std::int64_t start_ns;
+            std::int64_t duration_ns;
+        };
+
+        namespace _inner_impl {
+            // A span in a ring. The fields are atomic so that a reader can copy
+            // the span while its thread overwrites it: `seq` is the index of the
+            // span plus 1 once it's written, a copy is torn if `seq` changed.
+            struct slot {
+                std::atomic<std::uint64_t> seq{0};
+                std::atomic<const char *> name{nullptr};
+                std::atomic<const std::type_info *> input{nullptr};
+                std::atomic<const std::type_info *> output{nullptr};
+                std::atomic<std::size_t> input_size{0};
+                std::atomic<std::size_t> output_size{0};
+                std::atomic<std::int64_t> start_ns{0};
+                std::atomic<std::int64_t> duration_ns{0};
+            };
+
+            // Single-writer ring buffer of spans, written by its thread only.
+            struct ring {
+                std::unique_ptr<slot[]> spans;
+                std::size_t size;
+                std::size_t mask;
+                // Guarded by the lock of the registry.
+                unsigned tid;
+                bool exited = false;
+                std::atomic<std::uint64_t> head{0};
+                std::atomic<std::uint64_t> start{0};
+
+                ring(std::size_t capacity, unsigned id) : tid(id) {
+                    std::size_t n = 1;
+                    while (n < capacity) {
+                        n <<= 1;
+                    }
+                    spans.reset(new slot[n]);
+                    size = n;
+                    mask = n - 1;
+                }
+
+                void push(const span &s) {
+                    auto h = head.load(std::memory_order_relaxed);
+                    slot &x = spans[h & mask];
+                    x.seq.store(0, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_release);
+                    x.name.store(s.name, std::memory_order_relaxed);
+                    x.input.store(s.input, std::memory_order_relaxed);
+                    x.output.store(s.output, std::memory_order_relaxed);
+                    x.input_size.store(s.input_size, std::memory_order_relaxed);
+                    x.output_size.store(s.output_size, std::memory_order_relaxed);
+                    x.start_ns.store(s.start_ns, std::memory_order_relaxed);
+                    x.duration_ns.store(s.duration_ns, std::memory_order_relaxed);
+                    x.seq.store(h + 1, std::memory_order_release);
+                    head.store(h + 1, std::memory_order_release);
+                }
+
+                // Copy the span `i` into `s`, false if it has been overwritten.
+                bool read(std::uint64_t i, span &s) const {
+                    const slot &x = spans[i & mask];
+                    if (x.seq.load(std::memory_order_acquire) != i + 1) {
+                        return false;
+                    }
+                    s.name = x.name.load(std::memory_order_relaxed);
+                    s.input = x.input.load(std::memory_order_relaxed);
+                    s.output = x.output.load(std::memory_order_relaxed);
+                    s.input_size = x.input_size.load(std::memory_order_relaxed);
+                    s.output_size = x.output_size.load(std::memory_order_relaxed);
+                    s.start_ns = x.start_ns.load(std::memory_order_relaxed);
+                    s.duration_ns = x.duration_ns.load(std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    return x.seq.load(std::memory_order_relaxed) == i + 1;
+                }
+            };
+
+            struct registry {
+                std::mutex lock;
+                // The rings of the threads, and of the exited threads until flushed.
+                std::vector<std::shared_ptr<ring>> rings;
+                // The flushed rings of exited threads, to be reused.
+                std::vector<std::shared_ptr<ring>> free;
+                unsigned threads = 0;
+                std::atomic<bool> enabled{false};
+                std::atomic<std::size_t> capacity{std::size_t(1) << 16};
+
+                registry() {
+                    const char *env = std::getenv("ALGEBRA_TRACE");
+                    enabled.store(env && *env && *env != '0', std::memory_order_relaxed);
+                }
+
+                // A ring for a new thread, a free one of the current capacity if any.
+                std::shared_ptr<ring> acquire() {
+                    std::lock_guard<std::mutex> guard(lock);
+                    std::size_t n = capacity.load(std::memory_order_relaxed);
+                    std::shared_ptr<ring> r;
+                    while (!free.empty() && !r) {
+                        if (free.back()->size >= n && free.back()->size / 2 < n) {
+                            r = std::move(free.back());
+                        }
+                        free.pop_back();
+                    }
+                    if (r) {
+                        r->tid = ++threads;
+                        r->exited = false;
+                        r->start.store(r->head.load(std::memory_order_relaxed),
+                                       std::memory_order_relaxed);
+                    } else {
+                        r = std::make_shared<ring>(n, ++threads);
+                    }
+                    rings.push_back(r);
+                    return r;
+                }
+
+                void release(const std::shared_ptr<ring> &r) {
+                    std::lock_guard<std::mutex> guard(lock);
+                    r->exited = true;
+                }
+
+                // Once their spans are flushed, the rings of exited threads are free.
+                void recycle() {
+                    auto live = rings.begin();
+                    for (auto &r : rings) {
+                        if (r->exited) {
+                            free.push_back(std::move(r));
+                        } else {
+                            *live++ = std::move(r);
+                        }
+                    }
+                    rings.erase(live, rings.end());
+                }
+            };
+
+            inline registry &global() {
+                static registry r;
+                return r;
+            }
+
+            // Gives the ring of a thread back to the registry when the thread exits.
+            struct ring_owner {
+                std::shared_ptr<ring> r;
+
+                ~ring_owner() { global().release(r); }
+            };
+
+            // The ring of this thread, taken on first use.
+            inline ring &local() {
+                thread_local ring_owner owner{global().acquire()};
+                return *owner.r;
+            }
+
+            inline std::int64_t now_ns() {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now().time_since_epoch())
+                        .count();
+            }
+
+            template <typename C>
+            auto size_of(const C &c, int) -> decltype(std::size_t(c.size())) {
+                return c.size();
+            }
+
+            template <typename C>
+            std::size_t size_of(const C &, long) {
+                return 0;
+            }
+
+            // Write nanoseconds as microseconds, the unit of Chrome traces.
+            inline void write_us(std::ostream &out, std::int64_t ns) {
+                out << ns / 1000 << '.' << char('0' + ns % 1000 / 100) << char('0' + ns % 100 / 10)
+                    << char('0' + ns % 10);
+            }
+
+            inline std::string type_name(const std::type_info *t) {
+                std::string name = t->name();
+#if defined(__GNUG__)
+                int status = 0;
+                char *demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+                if (status == 0 && demangled) {
+                    name = demangled;
+                }
+                std::free(demangled);
+#endif
+                std::string escaped;
+                for (char c : name) {
+                    if (c == '"' || c == '\\') {
+                        escaped += '\\';
+                    }
+                    escaped += c;
+                }
+                return escaped;
+            }
+        };
+
+        inline void enable(bool on = true) {
+            _inner_impl::global().enabled.store(on, std::memory_order_relaxed);
+        }
+
+        inline void disable() { enable(false); }
+
+        inline bool enabled() {
+            return _inner_impl::global().enabled.load(std::memory_order_relaxed);
+        }
+
+        // The number of spans kept per thread, for threads that haven't traced yet.
+        inline void set_capacity(std::size_t spans) {
+            _inner_impl::global().capacity.store(spans ? spans : 1, std::memory_order_relaxed);
+        }
+
+        // Record a span on this thread, its name must outlive the trace (e.g. a
+        // string literal).
+        inline void record(const span &s) { _inner_impl::local().push(s); }
+
+        // Discard the spans recorded so far.
+        inline void clear() {
+            auto &g = _inner_impl::global();
+            std::lock_guard<std::mutex> guard(g.lock);
+            for (auto &r : g.rings) {
+                r->start.store(r->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+            }
+            g.recycle();
+        }
+
+        // Write the recorded spans as a Chrome trace JSON object.
+        inline void write_json(std::ostream &out) {
+            auto &g = _inner_impl::global();
+            std::lock_guard<std::mutex> guard(g.lock);
+            out << "{\"traceEvents\":[";
+            bool first = true;
+            for (auto &r : g.rings) {
+                std::uint64_t head = r->head.load(std::memory_order_acquire);
+                std::uint64_t begin = r->start.load(std::memory_order_relaxed);
+                if (head - begin > r->size) {
+                    begin = head - r->size;
+                }
+                for (auto i = begin; i < head; ++i) {
+                    span s;
+                    if (!r->read(i, s)) {
+                        continue;
+                    }
+                    out << (first ? "\n" : ",\n") << "{\"name\":\"" << s.name
+                        << "\",\"cat\":\"algebra\",\"ph\":\"X\",\"pid\":1,\"tid\":" << r->tid
+                        << ",\"ts\":";
+                    _inner_impl::write_us(out, s.start_ns);
+                    out << ",\"dur\":";
+                    _inner_impl::write_us(out, s.duration_ns);
+                    out << ",\"args\":{\"input\":\"" << _inner_impl::type_name(s.input)
+                        << "\",\"output\":\""
+                        << _inner_impl::type_name(s.output) << "\",\"input_size\":" << s.input_size
+                        << ",\"output_size\":" << s.output_size << "}}";
+                    first = false;
+                }
+            }
+            out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+            g.recycle();
+        }
+
+        // Call `thunk`, which applies the combinator `name` to `input`, and
+        // record its span when tracing is enabled.
+        template <typename In, typename Thunk>
+        auto traced(const char *name, const In &input, Thunk &&thunk) -> decltype(thunk()) {
+            if (enabled()) {
+                std::size_t input_size = _inner_impl::size_of(input, 0);
+                auto start = _inner_impl::now_ns();
+                auto result = thunk();
+                auto end = _inner_impl::now_ns();
+                record(span{name, &typeid(In), &typeid(decltype(result)), input_size,
+                            _inner_impl::size_of(result, 0), start, end - start});
+                return result;
+            }
+            return thunk();
+        }
+#else
+        template <typename In, typename Thunk>
+        auto traced(const char *, const In &, Thunk &&thunk) -> decltype(thunk()) {
+            return thunk();
+        }
+#endif
+    };
+};
+
+#endif /* __ALGEBRA_BASIC_TRACE_HPP__ */
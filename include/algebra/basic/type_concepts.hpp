@@ -505,6 +505,13 @@ namespace algebra {
     struct SameTemplate<T<Ts...>, U<Us...>> {
         static constexpr bool value = std::is_same<T<Ts...>, U<Ts...>>::value;
     };
+
+    // For fixed-size templates, e.g., std::array<int, 4> and std::array<float, 4>.
+    template <template <typename, std::size_t> class T, template <typename, std::size_t> class U,
+              typename Ta, typename Ua, std::size_t N, std::size_t M>
+    struct SameTemplate<T<Ta, N>, U<Ua, M>> {
+        static constexpr bool value = std::is_same<T<Ta, N>, U<Ta, N>>::value && N == M;
+    };
 };
 
 #endif /* __ALGEBRA_BASIC_TYPE_CONCEPTS_HPP__ */
@@ -5,6 +5,7 @@
 #ifndef __ALGEBRA_TYPE_OPERATION_HPP__
 #define __ALGEBRA_TYPE_OPERATION_HPP__
 
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 
@@ -35,6 +36,12 @@ namespace algebra {
         using type = T;
     };
 
+    // For fixed-size templates with a non-type size parameter, e.g., std::array<int, 4>
+    template <template <typename, std::size_t> class Tt, typename T, std::size_t N>
+    struct InnerType<Tt<T, N>> {
+        using type = T;
+    };
+
     /**
      * Bind parametric tempalte's type parameter with given type value.
      */
@@ -57,6 +64,13 @@ namespace algebra {
         struct rebind<Tt<T, Ts...>, U> {
             using type = Tt<U, Ts...>;
         };
+
+        // For fixed-size templates, keep the size parameter untouched.
+        template <template <typename, std::size_t> class Tt, typename T, std::size_t N,
+                  typename U>
+        struct rebind<Tt<T, N>, U> {
+            using type = Tt<U, N>;
+        };
     };
 
     template <typename T>
@@ -122,6 +136,33 @@ namespace algebra {
     template <typename F>
     using ResultOf = typename _inner_impl::decayed_result<F>::type;
 
+    /**
+     * Get the (decayed) argument type of an unary function, function pointer,
+     * or function object with a single non-template `operator()`.
+     */
+
+    namespace _inner_impl {
+        template <typename F>
+        struct unary_argument : unary_argument<decltype(&F::operator())> {};
+
+        template <typename R, typename A>
+        struct unary_argument<R(A)> {
+            using type = PlainType<A>;
+        };
+
+        template <typename R, typename A>
+        struct unary_argument<R (*)(A)> : unary_argument<R(A)> {};
+
+        template <typename R, typename C, typename A>
+        struct unary_argument<R (C::*)(A)> : unary_argument<R(A)> {};
+
+        template <typename R, typename C, typename A>
+        struct unary_argument<R (C::*)(A) const> : unary_argument<R(A)> {};
+    };
+
+    template <typename F>
+    using ArgumentOf = typename _inner_impl::unary_argument<PlainType<F>>::type;
+
     /**
      * Type-level control flow.
      */
@@ -6,11 +6,92 @@
 #define __ALGEBRA_BASIC_TYPE_REFLECTION_HPP__
 
 #include <iterator>
+#include <memory>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 /**
  * Simple reflection for modern C++.
  */
-namespace algebra {};
+namespace algebra {
+
+    /**
+     * Trivially relocatable types.
+     *
+     * Relocating an object, i.e., move constructing a new one from it then
+     * destroying it, amounts to copying its bytes for most types: the moved
+     * from object is never observed again, so it doesn't matter that both
+     * share their resources for a moment. Containers can then move a range of
+     * such elements to new storage with a single `memcpy`, without running
+     * any constructor or destructor.
+     *
+     * Trivially copyable types are trivially relocatable. Other types declare
+     * it with a member type
+     *
+     *      using trivially_relocatable = std::true_type;
+     *
+     * or, for types that can't be changed, by the macro
+     * `ALGEBRA_TRIVIALLY_RELOCATABLE(type)` at global scope. Types holding a
+     * pointer into themselves are not relocatable, e.g., `std::string` with
+     * a small string buffer or `std::list` with a sentinel node in libstdc++.
+     */
+    template <typename T, typename = void>
+    struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+    template <typename T>
+    struct is_trivially_relocatable<
+            T, typename std::enable_if<T::trivially_relocatable::value>::type> : std::true_type {};
+
+    // Smart pointers and vectors only hold pointers to their resources, in all
+    // major implementations of the standard library.
+    template <typename T>
+    struct is_trivially_relocatable<std::unique_ptr<T, std::default_delete<T>>, void>
+            : std::true_type {};
+
+    template <typename T>
+    struct is_trivially_relocatable<std::shared_ptr<T>, void> : std::true_type {};
+
+    template <typename T>
+    struct is_trivially_relocatable<std::weak_ptr<T>, void> : std::true_type {};
+
+    template <typename T>
+    struct is_trivially_relocatable<std::vector<T, std::allocator<T>>, void> : std::true_type {};
+
+    template <typename T1, typename T2>
+    struct is_trivially_relocatable<std::pair<T1, T2>, void>
+            : std::integral_constant<bool, is_trivially_relocatable<T1>::value &&
+                                                   is_trivially_relocatable<T2>::value> {};
+
+    /**
+     * Specifies that an object of the type can be relocated by copying its
+     * bytes.
+     */
+    template <typename T>
+    struct TriviallyRelocatable {
+        static constexpr bool value =
+                is_trivially_relocatable<typename std::remove_cv<T>::type>::value;
+        constexpr operator bool() const noexcept { return value; }
+    };
+
+    /**
+     * Specifies that the storage of an object of type `T` can be reused for
+     * an object of type `U`: both are trivially copyable and have the same
+     * size and alignment, e.g., `std::int32_t` and `float`.
+     */
+    template <typename T, typename U>
+    struct StorageCompatible {
+        static constexpr bool value = std::is_trivially_copyable<T>::value &&
+                                      std::is_trivially_copyable<U>::value &&
+                                      sizeof(T) == sizeof(U) && alignof(T) == alignof(U);
+        constexpr operator bool() const noexcept { return value; }
+    };
+};
+
+#define ALGEBRA_TRIVIALLY_RELOCATABLE(...)                                      \
+    namespace algebra {                                                         \
+        template <>                                                             \
+        struct is_trivially_relocatable<__VA_ARGS__, void> : std::true_type {}; \
+    }
 
 #endif /* __ALGEBRA_BASIC_TYPE_REFLECTION_HPP__ */
@@ -0,0 +1,77 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_BASIC_WORKER_GROUP_HPP__
+#define __ALGEBRA_BASIC_WORKER_GROUP_HPP__
+
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+/**
+ * The threads of the parallel combinators (`parallel_foldMap`, the parallel
+ * scans, `multiply` of matrices): the calling thread starts the workers and
+ * takes a share of the work itself.
+ *
+ * The workers are joined when the group goes out of scope, so an exception
+ * on the calling thread, or from starting a thread, doesn't destroy joinable
+ * threads. An exception in a worker is kept and rethrown by `join`, like a
+ * sequential run would throw it.
+ */
+namespace algebra {
+    namespace _inner_impl {
+
+        class worker_group {
+            std::vector<std::thread> threads_;
+            std::vector<std::exception_ptr> errors_;
+
+           public:
+            // A group of at most `n` workers.
+            explicit worker_group(std::size_t n) : errors_(n) { threads_.reserve(n); }
+
+            worker_group(const worker_group &) = delete;
+            worker_group &operator=(const worker_group &) = delete;
+
+            ~worker_group() {
+                for (auto &t : threads_) {
+                    if (t.joinable()) {
+                        t.join();
+                    }
+                }
+            }
+
+            template <typename Fn>
+            void spawn(Fn fn) {
+                assert(threads_.size() < errors_.size());
+                std::exception_ptr &error = errors_[threads_.size()];
+                threads_.emplace_back([&error, fn]() mutable {
+                    try {
+                        fn();
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                });
+            }
+
+            // Waits for all the workers, and rethrows the exception of the
+            // first one that failed.
+            void join() {
+                for (auto &t : threads_) {
+                    if (t.joinable()) {
+                        t.join();
+                    }
+                }
+                for (auto &e : errors_) {
+                    if (e) {
+                        std::rethrow_exception(e);
+                    }
+                }
+            }
+        };
+    };
+};
+
+#endif /* __ALGEBRA_BASIC_WORKER_GROUP_HPP__ */
@@ -0,0 +1,186 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_CONTROL_ALTERNATIVE_HPP__
+#define __ALGEBRA_CONTROL_ALTERNATIVE_HPP__
+
+#include <utility>
+#include "../basic/type_concepts.hpp"
+#include "../basic/type_operation.hpp"
+#include "../control/applicative.hpp"
+#include "../control/monad.hpp"
+#include "../prelude.hpp"
+
+/**
+ * Alternative and MonadPlus: computations that can fail, and a choice
+ * between computations. For the list monad the failure is the empty list and
+ * the choice is the concatenation, which makes searches prune their branches
+ * with `guard` and `mfilter`:
+ *
+ *      auto triples = range >>= [&](int a) {
+ *          return range >>= [&, a](int b) {
+ *              return guard(is_square(a * a + b * b), std::vector<int>{a, b});
+ *          };
+ *      };
+ */
+namespace algebra {
+
+    /**
+     * Alternative: a monoid on applicative functors.
+     * Alternative laws:
+     *  + empty <|> u = u
+     *  + u <|> empty = u
+     *  + u <|> (v <|> w) = (u <|> v) <|> w
+     */
+    template <typename F>
+    struct alternative {
+        /**
+         * Minimal complete definition.
+         */
+
+        // The identity of `<|>`.
+        // In Haskell:
+        //      empty :: alternative f => f a
+        static F empty();
+
+        // An associative binary operation.
+        // In Haskell:
+        //      (<|>) :: alternative f => f a -> f a -> f a
+        static F alt(const F &a, const F &b);
+
+        // Just a generic class.
+        static constexpr bool instance = false;
+    };
+
+    /**
+     * Alternative type predication.
+     */
+    template <typename F>
+    struct Alternative {
+        static constexpr bool value = alternative<F>::instance;
+        constexpr operator bool() const noexcept { return value; }
+    };
+
+    /**
+     * MonadPlus: monads that are also alternatives.
+     * MonadPlus laws:
+     *  + mzero >>= f = mzero
+     *  + v >> mzero = mzero
+     */
+    template <typename M>
+    struct monad_plus {
+        // Provide type signatures for this specialised monad.
+        using T = ValueType<M>;
+
+        /**
+         * Minimal complete definition.
+         */
+
+        // mzero: monad_plus m => m a.
+        static M mzero();
+
+        // mplus: monad_plus m => m a -> m a -> m a.
+        static M mplus(const M &a, const M &b);
+
+        /**
+         * Other useful methods.
+         */
+
+        // guard c >> m: monad_plus m => Bool -> m a -> m a.
+        static M guard(bool c, const M &m);
+
+        // mfilter: monad_plus m => (a -> Bool) -> m a -> m a.
+        template <typename P>
+        static M mfilter(P &&p, const M &m);
+
+        // Just a generic class.
+        static constexpr bool instance = false;
+    };
+
+    /**
+     * MonadPlus type predication.
+     */
+    template <typename M>
+    struct MonadPlus {
+        static constexpr bool value = monad_plus<M>::instance;
+        constexpr operator bool() const noexcept { return value; }
+    };
+
+    /**
+     * Default monad_plus, from the alternative instance and the monad instance.
+     */
+    template <typename M>
+    struct default_monad_plus {
+        using T = ValueType<M>;
+
+        static M mzero() { return alternative<M>::empty(); }
+
+        template <typename MA, typename MB>
+        static M mplus(MA &&a, MB &&b) {
+            return alternative<M>::alt(std::forward<MA>(a), std::forward<MB>(b));
+        }
+
+        static M guard(bool c, const M &m) { return c ? m : mzero(); }
+
+        static M guard(bool c, M &&m) { return c ? std::move(m) : mzero(); }
+
+        // In haskell:
+        //      mfilter p ma = do { a <- ma; if p a then return a else mzero }
+        template <typename P>
+        static M mfilter(P &&p, const M &m) {
+            return monad<M>::bind(m,
+                                  [&p](const T &x) { return p(x) ? monad<M>::pure(x) : mzero(); });
+        }
+
+        template <typename P>
+        static M mfilter(P &&p, M &&m) {
+            return monad<M>::bind(std::move(m), [&p](T &&x) {
+                return p(x) ? monad<M>::pure(std::move(x)) : mzero();
+            });
+        }
+
+        static constexpr bool instance = true;
+    };
+
+    /**
+     * Functions of alternative and monad_plus.
+     */
+
+    // The failure.
+    template <typename M, typename = Requires<MonadPlus<M>::value>>
+    M mzero() {
+        return monad_plus<M>::mzero();
+    }
+
+    // The choice.
+    template <typename MA, typename MB, typename M = PlainType<MA>,
+              typename = Requires<MonadPlus<M>{} && std::is_same<M, PlainType<MB>>::value>>
+    M mplus(MA &&a, MB &&b) {
+        return monad_plus<M>::mplus(std::forward<MA>(a), std::forward<MB>(b));
+    }
+
+    // The unit value if `c` holds, else the failure.
+    // In haskell:
+    //      guard :: alternative f => Bool -> f ()
+    template <typename F, typename = Requires<Alternative<F>::value>>
+    F guard(bool c) {
+        return c ? applicative<F>::pure(unit{}) : alternative<F>::empty();
+    }
+
+    // `guard c >> m`, without building the unit: the computation `m` if `c`
+    // holds, else the failure. A failed guard on an rvalue gives it back empty.
+    template <typename MA, typename M = PlainType<MA>, typename = Requires<MonadPlus<M>::value>>
+    M guard(bool c, MA &&m) {
+        return monad_plus<M>::guard(c, std::forward<MA>(m));
+    }
+
+    // The values that satisfy `p`.
+    template <typename P, typename MA, typename M = PlainType<MA>,
+              typename = Requires<MonadPlus<M>::value>>
+    M mfilter(P &&p, MA &&m) {
+        return monad_plus<M>::mfilter(std::forward<P>(p), std::forward<MA>(m));
+    }
+};
+
+#endif /* __ALGEBRA_CONTROL_ALTERNATIVE_HPP__ */
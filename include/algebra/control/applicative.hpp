@@ -5,6 +5,9 @@
 #ifndef __ALGEBRA_H_CONTROL_APPLICATIVE_HPP__
 #define __ALGEBRA_H_CONTROL_APPLICATIVE_HPP__
 
+#include <type_traits>
+#include <utility>
+#include "../basic/trace.hpp"
 #include "../basic/type_concepts.hpp"
 #include "../basic/type_operation.hpp"
 #include "../control/functor.hpp"
@@ -116,19 +119,35 @@ namespace algebra {
      * Operator overloading for applicative functor operation.
      */
 
-    // Overloading `*` as `ap`.
+    namespace _inner_impl {
+        // Whether the elements of `Fn` are functions of the elements of `F`.
+        template <typename Fn, typename F, typename = void>
+        struct applies_to : std::false_type {};
+
+        template <typename Fn, typename F>
+        struct applies_to<Fn, F,
+                          decltype(std::declval<ValueType<Fn> &>()(std::declval<ValueType<F>>()),
+                                   void())> : std::true_type {};
+    };
+
+    // Overloading `*` as `ap`, for functions only, `*` on containers of
+    // numbers is left to the arithmetic of the container, e.g., `zip_list`.
     template <typename Ff, typename F, typename Fn = PlainType<Ff>, typename _F = PlainType<F>,
               typename = Requires<Applicative<_F>::value>,
-              typename = Requires<SameTemplate<Fn, _F>::value>>
+              typename = Requires<SameTemplate<Fn, _F>::value>,
+              typename = Requires<_inner_impl::applies_to<Fn, _F>::value>>
     auto operator*(Ff &&u, F &&v) {
-        return applicative<_F>::ap(std::forward<Ff>(u), std::forward<F>(v));
+        return trace::traced("ap", v, [&] {
+            return applicative<_F>::ap(std::forward<Ff>(u), std::forward<F>(v));
+        });
     }
 
     template <typename Ff, typename F, typename Fn = PlainType<Ff>, typename _F = PlainType<F>,
               typename = Requires<Applicative<_F>::value>,
-              typename = Requires<SameTemplate<Fn, _F>::value>>
+              typename = Requires<SameTemplate<Fn, _F>::value>,
+              typename = Requires<_inner_impl::applies_to<Fn, _F>::value>>
     auto operator*(Ff &&u, const F &v) {
-        return applicative<_F>::ap(std::forward<Ff>(u), v);
+        return trace::traced("ap", v, [&] { return applicative<_F>::ap(std::forward<Ff>(u), v); });
     }
 };
 
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <functional>
+#include "../basic/trace.hpp"
 #include "../basic/type_concepts.hpp"
 #include "../basic/type_operation.hpp"
 
@@ -70,7 +71,9 @@ namespace algebra {
             typename = Requires<Functor<_F>::value && !std::is_member_function_pointer<Fn>::value>>
     auto operator%(Fn&& fn, F&& f)
             -> decltype(functor<_F>::fmap(std::forward<Fn>(fn), std::forward<F>(f))) {
-        return functor<_F>::fmap(std::forward<Fn>(fn), std::forward<F>(f));
+        return trace::traced("fmap", f, [&] {
+            return functor<_F>::fmap(std::forward<Fn>(fn), std::forward<F>(f));
+        });
     }
 
     // For use member function pointer as `Fn`.
@@ -79,7 +82,8 @@ namespace algebra {
             typename = Requires<Functor<_F>::value && !std::is_member_function_pointer<Fn>::value>>
     auto operator%(R (Fn::*fn)(), F&& f)
             -> decltype(functor<_F>::fmap(std::mem_fn(fn), std::forward<F>(f))) {
-        return functor<_F>::fmap(std::mem_fn(fn), std::forward<F>(f));
+        return trace::traced(
+                "fmap", f, [&] { return functor<_F>::fmap(std::mem_fn(fn), std::forward<F>(f)); });
     }
 
     // For use transformed lambda expression as `Fn`.
@@ -88,7 +92,8 @@ namespace algebra {
             typename = Requires<Functor<_F>::value && !std::is_member_function_pointer<Fn>::value>>
     auto operator%(R (Fn::*fn)() const, F&& f)
             -> decltype(functor<_F>::fmap(std::mem_fn(fn), std::forward<F>(f))) {
-        return functor<_F>::fmap(std::mem_fn(fn), std::forward<F>(f));
+        return trace::traced(
+                "fmap", f, [&] { return functor<_F>::fmap(std::mem_fn(fn), std::forward<F>(f)); });
     }
 };
 
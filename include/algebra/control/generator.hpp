@@ -0,0 +1,395 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_CONTROL_GENERATOR_HPP__
+#define __ALGEBRA_CONTROL_GENERATOR_HPP__
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include "../basic/type_concepts.hpp"
+#include "../basic/type_operation.hpp"
+#include "../control/functor.hpp"
+#include "../data/foldable.hpp"
+#include "../data/monoid.hpp"
+
+/**
+ * Lazy, possibly infinite sequences: `iota`, `repeat`, `cycle`, `iterate` and
+ * `unfold`, cut to a finite length by `take` and `takeWhile`.
+ *
+ * Unlike `stream`, a generator keeps its whole state by value in a type built
+ * at compile time, so it never allocates and every step can be inlined. `fmap`
+ * gives a generator whose state is the one of the source plus the function,
+ * and mapping a mapped generator composes the functions. Copies of a
+ * generator are independent.
+ *
+ * e.g.:
+ *      auto squares = [](int x) { return x * x; } % iota(1);
+ *      int first;
+ *      find([](int x) { return x > 1000; }, squares, first);  // 1024
+ *      auto total = foldMap([](int x) { return sum(x); }, take(10, squares));
+ *
+ * Folding or iterating an infinite generator doesn't terminate: `take`,
+ * `takeWhile` and `find` are the short-circuiting consumers. The values must
+ * be default constructible.
+ */
+namespace algebra {
+
+    /**
+     * A generator with state `G`, which has a `value_type` and stores the next
+     * value with `bool next(value_type &)`, giving false at the end.
+     */
+    template <typename G>
+    class generator {
+        G g_;
+
+       public:
+        using value_type = typename G::value_type;
+        using state_type = G;
+
+        // Iterating pulls the values from the generator itself.
+        class iterator {
+           public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = typename G::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type *;
+            using reference = const value_type &;
+
+           private:
+            generator *g_;
+            value_type value_;
+
+           public:
+
+            iterator() : g_(nullptr), value_() {}
+            explicit iterator(generator *g) : g_(g), value_() { ++*this; }
+
+            reference operator*() const { return value_; }
+            pointer operator->() const { return &value_; }
+
+            iterator &operator++() {
+                if (g_ && !g_->next(value_)) {
+                    g_ = nullptr;
+                }
+                return *this;
+            }
+
+            friend bool operator==(const iterator &a, const iterator &b) { return a.g_ == b.g_; }
+            friend bool operator!=(const iterator &a, const iterator &b) { return a.g_ != b.g_; }
+        };
+
+        explicit generator(G g) : g_(std::move(g)) {}
+
+        // Pull the next value, return false at the end.
+        bool next(value_type &out) { return g_.next(out); }
+
+        const G &state() const & { return g_; }
+        G &&state() && { return std::move(g_); }
+
+        iterator begin() { return iterator(this); }
+        iterator end() { return iterator(); }
+    };
+
+    namespace _inner_impl {
+        template <typename T>
+        struct iota_state {
+            using value_type = T;
+            T current, step;
+
+            bool next(T &out) {
+                out = current;
+                current += step;
+                return true;
+            }
+        };
+
+        template <typename T>
+        struct repeat_state {
+            using value_type = T;
+            T value;
+
+            bool next(T &out) {
+                out = value;
+                return true;
+            }
+        };
+
+        // The position is kept as an iterator, and as an index to rebuild the
+        // iterator in copies, whose containers are elsewhere.
+        template <typename C>
+        struct cycle_state {
+            using value_type = ValueType<C>;
+            using iterator = decltype(std::begin(std::declval<C &>()));
+            C c;
+            iterator it;
+            std::size_t i = 0;
+
+            explicit cycle_state(C xs) : c(std::move(xs)), it(std::begin(c)) {}
+
+            cycle_state(const cycle_state &other) : c(other.c), it(at(other.i)), i(other.i) {}
+
+            cycle_state(cycle_state &&other) : c(std::move(other.c)), it(at(other.i)), i(other.i) {}
+
+            cycle_state &operator=(cycle_state other) {
+                c = std::move(other.c);
+                i = other.i;
+                it = at(i);
+                return *this;
+            }
+
+            iterator at(std::size_t k) {
+                return std::next(std::begin(c), static_cast<std::ptrdiff_t>(k));
+            }
+
+            bool next(value_type &out) {
+                if (it == std::end(c)) {
+                    if (i == 0) {
+                        return false;
+                    }
+                    it = std::begin(c);
+                    i = 0;
+                }
+                out = *it;
+                ++it;
+                ++i;
+                return true;
+            }
+        };
+
+        template <typename T, typename Fn>
+        struct iterate_state {
+            using value_type = T;
+            T x;
+            Fn fn;
+            bool started;
+
+            bool next(T &out) {
+                if (started) {
+                    x = fn(x);
+                }
+                started = true;
+                out = x;
+                return true;
+            }
+        };
+
+        template <typename T, typename S, typename Fn>
+        struct unfold_state {
+            using value_type = T;
+            S seed;
+            Fn fn;
+
+            bool next(T &out) { return fn(seed, out); }
+        };
+
+        template <typename G, typename Fn>
+        struct mapped_state {
+            using value_type = ResultOf<Fn(typename G::value_type)>;
+            G g;
+            Fn fn;
+
+            bool next(value_type &out) {
+                typename G::value_type x;
+                if (!g.next(x)) {
+                    return false;
+                }
+                out = fn(std::move(x));
+                return true;
+            }
+        };
+
+        // `g . f`, the function of a mapped generator mapped again.
+        template <typename F, typename G>
+        struct composed {
+            F f;
+            G g;
+
+            template <typename T>
+            auto operator()(T &&x) -> decltype(g(f(std::forward<T>(x)))) {
+                return g(f(std::forward<T>(x)));
+            }
+        };
+
+        template <typename G>
+        struct take_state {
+            using value_type = typename G::value_type;
+            G g;
+            std::size_t n;
+
+            bool next(value_type &out) {
+                if (n == 0) {
+                    return false;
+                }
+                --n;
+                return g.next(out);
+            }
+        };
+
+        template <typename G, typename P>
+        struct take_while_state {
+            using value_type = typename G::value_type;
+            G g;
+            P p;
+            bool done;
+
+            bool next(value_type &out) {
+                if (done || !g.next(out) || !p(out)) {
+                    done = true;
+                    return false;
+                }
+                return true;
+            }
+        };
+    };
+
+    /**
+     * Sources.
+     */
+
+    // start, start + step, start + 2 * step, ...
+    template <typename T>
+    generator<_inner_impl::iota_state<T>> iota(T start, T step = T(1)) {
+        return generator<_inner_impl::iota_state<T>>({std::move(start), std::move(step)});
+    }
+
+    // x, x, x, ...
+    template <typename T>
+    generator<_inner_impl::repeat_state<T>> repeat(T x) {
+        return generator<_inner_impl::repeat_state<T>>({std::move(x)});
+    }
+
+    // The elements of `c` over and over, none if it's empty. The container is
+    // copied into the generator, cycle an `array_view` to avoid the copy.
+    template <typename C>
+    generator<_inner_impl::cycle_state<PlainType<C>>> cycle(C &&c) {
+        return generator<_inner_impl::cycle_state<PlainType<C>>>(
+                _inner_impl::cycle_state<PlainType<C>>(std::forward<C>(c)));
+    }
+
+    // x, fn(x), fn(fn(x)), ...
+    template <typename Fn, typename T>
+    generator<_inner_impl::iterate_state<T, PlainType<Fn>>> iterate(Fn &&fn, T x) {
+        return generator<_inner_impl::iterate_state<T, PlainType<Fn>>>(
+                {std::move(x), std::forward<Fn>(fn), false});
+    }
+
+    // The values stored by `fn(seed, out)` until it gives false, the seed is
+    // the state of the generator.
+    // In Haskell:
+    //      unfoldr :: (b -> Maybe (a, b)) -> b -> [a]
+    template <typename T, typename S, typename Fn>
+    generator<_inner_impl::unfold_state<T, S, PlainType<Fn>>> unfold(S seed, Fn &&fn) {
+        return generator<_inner_impl::unfold_state<T, S, PlainType<Fn>>>(
+                {std::move(seed), std::forward<Fn>(fn)});
+    }
+
+    /**
+     * Consumers.
+     */
+
+    // The first `n` values.
+    template <typename G>
+    generator<_inner_impl::take_state<G>> take(std::size_t n, generator<G> g) {
+        return generator<_inner_impl::take_state<G>>({std::move(g).state(), n});
+    }
+
+    // The values before the first one that doesn't satisfy `p`.
+    template <typename P, typename G>
+    generator<_inner_impl::take_while_state<G, PlainType<P>>> takeWhile(P &&p, generator<G> g) {
+        return generator<_inner_impl::take_while_state<G, PlainType<P>>>(
+                {std::move(g).state(), std::forward<P>(p), false});
+    }
+
+    // Store the first value that satisfies `p` into `out`, return false when
+    // the generator ends without one.
+    template <typename P, typename G>
+    bool find(P &&p, generator<G> g, typename G::value_type &out) {
+        while (g.next(out)) {
+            if (p(out)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Generators have no `rebind`: the type of a mapped generator depends on
+    // the function.
+    template <typename G>
+    struct parametric_type_traits<generator<G>> {
+        using value_type = typename G::value_type;
+    };
+
+    /**
+     * generator as functor, the function is applied as values are pulled.
+     */
+    template <typename G>
+    struct functor<generator<G>> {
+        template <typename Fn, typename M = _inner_impl::mapped_state<G, PlainType<Fn>>>
+        static generator<M> fmap(Fn &&fn, const generator<G> &f) {
+            return generator<M>({f.state(), std::forward<Fn>(fn)});
+        }
+
+        template <typename Fn, typename M = _inner_impl::mapped_state<G, PlainType<Fn>>>
+        static generator<M> fmap(Fn &&fn, generator<G> &&f) {
+            return generator<M>({std::move(f).state(), std::forward<Fn>(fn)});
+        }
+
+        static constexpr bool instance = true;
+    };
+
+    template <typename G, typename F>
+    struct functor<generator<_inner_impl::mapped_state<G, F>>> {
+        template <typename Fn>
+        using composed = _inner_impl::composed<F, PlainType<Fn>>;
+
+        template <typename Fn, typename M = _inner_impl::mapped_state<G, composed<Fn>>>
+        static generator<M> fmap(Fn &&fn,
+                                 const generator<_inner_impl::mapped_state<G, F>> &f) {
+            return generator<M>({f.state().g, {f.state().fn, std::forward<Fn>(fn)}});
+        }
+
+        template <typename Fn, typename M = _inner_impl::mapped_state<G, composed<Fn>>>
+        static generator<M> fmap(Fn &&fn, generator<_inner_impl::mapped_state<G, F>> &&f) {
+            auto s = std::move(f).state();
+            return generator<M>({std::move(s.g), {std::move(s.fn), std::forward<Fn>(fn)}});
+        }
+
+        static constexpr bool instance = true;
+    };
+
+    /**
+     * generator as foldable, a copy of the generator is consumed. There is no
+     * `foldr`, a generator can only be traversed forwards.
+     */
+    template <typename G>
+    struct foldable<generator<G>> {
+        using T = typename G::value_type;
+
+        template <typename Fn, typename B>
+        static B foldl(Fn &&fn, B z, const generator<G> &f) {
+            generator<G> g = f;
+            T x;
+            while (g.next(x)) {
+                z = fn(std::move(z), x);
+            }
+            return z;
+        }
+
+        template <typename Fn, typename M = ResultOf<Fn(T)>, typename = Requires<Monoid<M>::value>>
+        static M foldMap(Fn &&fn, const generator<G> &f) {
+            generator<G> g = f;
+            M acc = monoid<M>::mempty();
+            T x;
+            while (g.next(x)) {
+                acc = monoid<M>::mappend(std::move(acc), fn(x));
+            }
+            return acc;
+        }
+
+        static constexpr bool instance = true;
+    };
+};
+
+#endif /* __ALGEBRA_CONTROL_GENERATOR_HPP__ */
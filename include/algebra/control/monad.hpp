@@ -5,6 +5,8 @@
 #ifndef __ALGEBRA_CONTROL_MONAD_HPP__
 #define __ALGEBRA_CONTROL_MONAD_HPP__
 
+#include "../basic/instrument.hpp"
+#include "../basic/trace.hpp"
 #include "../basic/type_concepts.hpp"
 #include "../basic/type_operation.hpp"
 #include "../control/applicative.hpp"
@@ -54,6 +56,10 @@ namespace algebra {
         template <typename F, typename U = ResultOf<F(T)>>
         static _M<U> liftM(F &&fn, const _M<T> &m);
 
+        // then: monad m => m a -> m b -> m b.
+        template <typename MB>
+        static MB then(const _M<T> &m, const MB &mb);
+
         // Just a generic type class, not monad instance.
         static constexpr bool instance = false;
     };
@@ -103,9 +109,13 @@ namespace algebra {
         template <typename U>
         using _M = Rebind<M, U>;
 
-        static constexpr _M<T> join(const _M<_M<T>> &m) { return monad<_M<_M<T>>>::bind(m, _id); }
+        static _M<T> join(const _M<_M<T>> &m) {
+            ALGEBRA_INSTRUMENT_SCOPE(join);
+            return monad<_M<_M<T>>>::bind(m, _id);
+        }
 
-        static constexpr _M<T> join(_M<_M<T>> &&m) {
+        static _M<T> join(_M<_M<T>> &&m) {
+            ALGEBRA_INSTRUMENT_SCOPE(join);
             return monad<_M<_M<T>>>::bind(std::move(m), _id);
         }
     };
@@ -151,8 +161,21 @@ namespace algebra {
         }
     };
 
+    // then: monad m => m a -> m b -> m b.
+    // In haskell:
+    //      m1 >> m2 = m1 >>= \_ -> m2
+    template <typename M>
+    struct default_then {
+        using T = ValueType<M>;
+
+        template <typename MA, typename MB, typename _MB = PlainType<MB>>
+        static _MB then(MA &&ma, const MB &mb) {
+            return monad<M>::bind(std::forward<MA>(ma), [&mb](const T &) { return mb; });
+        }
+    };
+
     /**
-     * Default monad with default "pure", "bind", "join", "ap" and "liftM".
+     * Default monad with default "pure", "bind", "join", "ap", "liftM" and "then".
      */
 
     template <typename M>
@@ -160,7 +183,8 @@ namespace algebra {
                            default_bind<M>,
                            default_join<M>,
                            default_ap<M>,
-                           default_liftM<M> {
+                           default_liftM<M>,
+                           default_then<M> {
         static constexpr bool instance = true;
     };
 
@@ -175,7 +199,8 @@ namespace algebra {
     template <typename M, typename F, typename _M = PlainType<M>,
               typename = Requires<Monad<_M>{} && !std::is_member_function_pointer<F>::value>>
     auto operator>>=(M &&m, F &&f) -> decltype(monad<_M>::bind(std::move(m), std::forward<F>(f))) {
-        return monad<_M>::bind(std::move(m), std::forward<F>(f));
+        return trace::traced(
+                "bind", m, [&] { return monad<_M>::bind(std::move(m), std::forward<F>(f)); });
     }
 
     // for lambda expression.
@@ -200,11 +225,14 @@ namespace algebra {
 
     // Use `>>` to represent the bind with discard the first result. The two monadic
     // compuatation will be all performed.
+    //
+    // The result is what `monad<MA>::then` gives, which may be a lazy view that
+    // converts to `MB` (see `repeated` for sequence containers).
     template <typename MA, typename MB, typename _MA = PlainType<MA>, typename _MB = PlainType<MB>,
               typename = Requires<Monad<_MA>{} && Monad<_MB>{}>>
-    _MB operator>>(MA &&, MB &&) {
-        // TODO
-        // return std::forward<MA>(ma) >>= _const(std::forward<MB>(mb));
+    auto operator>>(MA &&ma, MB &&mb)
+            -> decltype(monad<_MA>::then(std::forward<MA>(ma), std::forward<MB>(mb))) {
+        return monad<_MA>::then(std::forward<MA>(ma), std::forward<MB>(mb));
     }
 }
 
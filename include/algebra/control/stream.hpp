@@ -0,0 +1,184 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_CONTROL_STREAM_HPP__
+#define __ALGEBRA_CONTROL_STREAM_HPP__
+
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include "../basic/type_concepts.hpp"
+#include "../basic/type_operation.hpp"
+#include "../control/functor.hpp"
+#include "../control/monad.hpp"
+#include "../data/foldable.hpp"
+
+/**
+ * Lazy, single-pass stream of values, pulled one at a time from a source
+ * (e.g. the records of a file, see `read_records`). `fmap` and `bind` build
+ * new streams without reading anything, the values flow through the whole
+ * pipeline only when the stream is consumed, so memory use doesn't depend on
+ * the length of the stream.
+ *
+ * Copies of a stream share the position of the source: a value pulled from one
+ * copy is not seen by the others.
+ *
+ * e.g.:
+ *      auto lengths = [](array_view<const char> l) { return l.size(); } % lines(path);
+ *      for (auto n : lengths) { ... }
+ */
+namespace algebra {
+
+    template <typename T>
+    class stream {
+       public:
+        // Store the next value into the argument, return false at the end.
+        using pull_type = std::function<bool(T &)>;
+
+       private:
+        std::shared_ptr<pull_type> pull_;
+
+       public:
+        using value_type = T;
+
+        class iterator {
+            const stream *s_;
+            T value_;
+
+           public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T *;
+            using reference = const T &;
+
+            iterator() : s_(nullptr), value_() {}
+            explicit iterator(const stream *s) : s_(s), value_() { ++*this; }
+
+            reference operator*() const { return value_; }
+            pointer operator->() const { return &value_; }
+
+            iterator &operator++() {
+                if (s_ && !s_->next(value_)) {
+                    s_ = nullptr;
+                }
+                return *this;
+            }
+
+            // All iterators of a stream share its position, `end()` is the
+            // only position that can be compared meaningfully.
+            friend bool operator==(const iterator &a, const iterator &b) { return a.s_ == b.s_; }
+            friend bool operator!=(const iterator &a, const iterator &b) { return a.s_ != b.s_; }
+        };
+
+        using const_iterator = iterator;
+
+        // An empty stream.
+        stream() = default;
+
+        template <typename Fn, typename = Requires<!std::is_same<PlainType<Fn>, stream>::value>>
+        explicit stream(Fn &&pull) : pull_(std::make_shared<pull_type>(std::forward<Fn>(pull))) {}
+
+        // Pull the next value, return false at the end of the stream.
+        bool next(T &out) const { return pull_ && (*pull_)(out); }
+
+        iterator begin() const { return iterator(this); }
+        iterator end() const { return iterator(); }
+    };
+
+    // The stream of the elements of a container, which is copied into the
+    // stream with the iterator to its next element.
+    template <typename C, typename T = ValueType<PlainType<C>>>
+    stream<T> make_stream(C &&c) {
+        using It = decltype(std::begin(std::declval<PlainType<C> &>()));
+        auto state = std::make_shared<std::pair<PlainType<C>, It>>(std::forward<C>(c), It());
+        state->second = std::begin(state->first);
+        return stream<T>([state](T &out) {
+            if (state->second == std::end(state->first)) {
+                return false;
+            }
+            out = *state->second++;
+            return true;
+        });
+    }
+
+    template <typename T>
+    struct parametric_type_traits<stream<T>> {
+        using value_type = T;
+
+        template <typename U>
+        using rebind = stream<U>;
+    };
+
+    /**
+     * stream as functor, the function is applied when a value is pulled.
+     */
+    template <typename T>
+    struct functor<stream<T>> {
+        template <typename U>
+        using _F = stream<U>;
+
+        template <typename Fn, typename U = ResultOf<Fn(T)>>
+        static _F<U> fmap(Fn &&fn, const _F<T> &f) {
+            return _F<U>([f, fn = PlainType<Fn>(std::forward<Fn>(fn))](U &out) {
+                T t;
+                if (!f.next(t)) {
+                    return false;
+                }
+                out = fn(std::move(t));
+                return true;
+            });
+        }
+
+        static constexpr bool instance = true;
+    };
+
+    /**
+     * stream as monad, `bind` concatenates the streams given by the function,
+     * each of them is consumed before the next value of the outer stream is
+     * pulled.
+     */
+    template <typename T>
+    struct monad<stream<T>> : default_monad<stream<T>> {
+        template <typename U>
+        using _M = stream<U>;
+
+        static _M<T> pure(const T &x) {
+            auto done = std::make_shared<bool>(false);
+            return _M<T>([x, done](T &out) {
+                if (*done) {
+                    return false;
+                }
+                *done = true;
+                out = x;
+                return true;
+            });
+        }
+
+        template <typename F, typename R = ResultOf<F(T)>, typename U = ValueType<R>>
+        static _M<U> bind(const _M<T> &m, F &&f) {
+            auto inner = std::make_shared<R>();
+            return _M<U>([m, f = PlainType<F>(std::forward<F>(f)), inner](U &out) {
+                while (!inner->next(out)) {
+                    T t;
+                    if (!m.next(t)) {
+                        return false;
+                    }
+                    *inner = f(std::move(t));
+                }
+                return true;
+            });
+        }
+    };
+
+    /**
+     * stream as foldable, folding consumes the stream. There is no `foldr`, a
+     * stream can only be traversed forwards.
+     */
+    template <typename T>
+    struct foldable<stream<T>> : default_foldable<stream<T>> {};
+};
+
+#endif /* __ALGEBRA_CONTROL_STREAM_HPP__ */
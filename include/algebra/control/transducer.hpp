@@ -0,0 +1,481 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_CONTROL_TRANSDUCER_HPP__
+#define __ALGEBRA_CONTROL_TRANSDUCER_HPP__
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../basic/type_concepts.hpp"
+#include "../basic/type_operation.hpp"
+#include "../data/array_view.hpp"
+#include "../data/foldable.hpp"
+#include "../data/monoid.hpp"
+
+/**
+ * Transducers: transformations of a fold, rather than of a container. A chain
+ * of steps like
+ *
+ *      auto xs = xf::filter(is_valid) | xf::map(latency) | xf::take(1000);
+ *      auto total = foldMap(xs, [](double x) { return sum(x); }, events);
+ *
+ * is fused into a single reducing function: every element goes through the
+ * whole chain before the next one is read, no intermediate container is built,
+ * and `take` and `take_while` stop the traversal early.
+ *
+ * A transducer has
+ *
+ *  + `result_type<X>`, the type of the elements it gives for elements of `X`,
+ *  + `apply<X>(next)`, a reducer for elements of `X` feeding `next`. Reducers
+ *    have `bool step(acc, x)`, giving false to stop the traversal, and
+ *    `complete(acc)`, which flushes what they hold back at the end,
+ *  + `stateless`, true if every element is transformed independently of the
+ *    others, which allows folding in parallel.
+ *
+ * Transducers are composed by `|`, the elements flow from left to right.
+ */
+namespace algebra {
+
+    /**
+     * Base of transducers.
+     */
+    struct transducer_tag {};
+
+    /**
+     * Specifies that the type is a transducer.
+     */
+    template <typename T>
+    struct Transducer {
+        static constexpr bool value = std::is_base_of<transducer_tag, PlainType<T>>::value;
+        constexpr operator bool() const noexcept { return value; }
+    };
+
+    namespace _inner_impl {
+        // The reducer at the end of a chain, combining the accumulator and an
+        // element with `fn(acc, x) -> acc`.
+        template <typename Fn>
+        struct reducing {
+            Fn fn;
+
+            template <typename A, typename X>
+            bool step(A &acc, X &&x) {
+                acc = fn(std::move(acc), std::forward<X>(x));
+                return true;
+            }
+
+            template <typename A>
+            void complete(A &) {}
+        };
+
+        // `mappend acc (fn x)`, the reducing function of `foldMap`.
+        template <typename M, typename Fn>
+        struct mappending {
+            Fn &fn;
+
+            template <typename X>
+            M operator()(M acc, X &&x) const {
+                return monoid<M>::mappend(std::move(acc), fn(std::forward<X>(x)));
+            }
+        };
+
+        // The type of the elements of a range.
+        template <typename F>
+        using element_type = typename std::iterator_traits<decltype(
+                std::begin(std::declval<const F &>()))>::value_type;
+
+        template <typename X, typename Xf, typename A, typename Fn, typename F>
+        void run_transducer(const Xf &xf, A &acc, Fn fn, const F &f) {
+            auto r = xf.template apply<X>(reducing<Fn>{std::move(fn)});
+            for (auto &&e : f) {
+                if (!r.step(acc, e)) {
+                    break;
+                }
+            }
+            r.complete(acc);
+        }
+    };
+
+    namespace xf {
+
+        /**
+         * map fn: every element `x` gives `fn(x)`.
+         */
+        template <typename Fn>
+        struct mapping : transducer_tag {
+            static constexpr bool stateless = true;
+
+            template <typename X>
+            using result_type = ResultOf<Fn(X)>;
+
+            template <typename R>
+            struct reducer {
+                Fn fn;
+                R next;
+
+                template <typename A, typename X>
+                bool step(A &acc, X &&x) {
+                    return next.step(acc, fn(std::forward<X>(x)));
+                }
+
+                template <typename A>
+                void complete(A &acc) {
+                    next.complete(acc);
+                }
+            };
+
+            Fn fn;
+
+            explicit mapping(Fn f) : fn(std::move(f)) {}
+
+            template <typename X, typename R>
+            reducer<R> apply(R next) const {
+                return reducer<R>{fn, std::move(next)};
+            }
+        };
+
+        template <typename Fn>
+        mapping<PlainType<Fn>> map(Fn &&fn) {
+            return mapping<PlainType<Fn>>(std::forward<Fn>(fn));
+        }
+
+        /**
+         * filter p: the elements satisfying `p`.
+         */
+        template <typename P>
+        struct filtering : transducer_tag {
+            static constexpr bool stateless = true;
+
+            template <typename X>
+            using result_type = X;
+
+            template <typename R>
+            struct reducer {
+                P p;
+                R next;
+
+                template <typename A, typename X>
+                bool step(A &acc, X &&x) {
+                    return p(x) ? next.step(acc, std::forward<X>(x)) : true;
+                }
+
+                template <typename A>
+                void complete(A &acc) {
+                    next.complete(acc);
+                }
+            };
+
+            P p;
+
+            explicit filtering(P pred) : p(std::move(pred)) {}
+
+            template <typename X, typename R>
+            reducer<R> apply(R next) const {
+                return reducer<R>{p, std::move(next)};
+            }
+        };
+
+        template <typename P>
+        filtering<PlainType<P>> filter(P &&p) {
+            return filtering<PlainType<P>>(std::forward<P>(p));
+        }
+
+        /**
+         * take n: the first `n` elements, then the traversal stops.
+         */
+        struct taking : transducer_tag {
+            static constexpr bool stateless = false;
+
+            template <typename X>
+            using result_type = X;
+
+            template <typename R>
+            struct reducer {
+                std::size_t remaining;
+                R next;
+
+                template <typename A, typename X>
+                bool step(A &acc, X &&x) {
+                    if (remaining == 0) {
+                        return false;
+                    }
+                    --remaining;
+                    return next.step(acc, std::forward<X>(x)) && remaining != 0;
+                }
+
+                template <typename A>
+                void complete(A &acc) {
+                    next.complete(acc);
+                }
+            };
+
+            std::size_t n;
+
+            explicit taking(std::size_t count) : n(count) {}
+
+            template <typename X, typename R>
+            reducer<R> apply(R next) const {
+                return reducer<R>{n, std::move(next)};
+            }
+        };
+
+        inline taking take(std::size_t n) { return taking(n); }
+
+        /**
+         * take_while p: the elements before the first one that doesn't satisfy
+         * `p`, then the traversal stops.
+         */
+        template <typename P>
+        struct taking_while : transducer_tag {
+            static constexpr bool stateless = false;
+
+            template <typename X>
+            using result_type = X;
+
+            template <typename R>
+            struct reducer {
+                P p;
+                R next;
+
+                template <typename A, typename X>
+                bool step(A &acc, X &&x) {
+                    return p(x) && next.step(acc, std::forward<X>(x));
+                }
+
+                template <typename A>
+                void complete(A &acc) {
+                    next.complete(acc);
+                }
+            };
+
+            P p;
+
+            explicit taking_while(P pred) : p(std::move(pred)) {}
+
+            template <typename X, typename R>
+            reducer<R> apply(R next) const {
+                return reducer<R>{p, std::move(next)};
+            }
+        };
+
+        template <typename P>
+        taking_while<PlainType<P>> take_while(P &&p) {
+            return taking_while<PlainType<P>>(std::forward<P>(p));
+        }
+
+        /**
+         * drop n: the elements after the first `n`.
+         */
+        struct dropping : transducer_tag {
+            static constexpr bool stateless = false;
+
+            template <typename X>
+            using result_type = X;
+
+            template <typename R>
+            struct reducer {
+                std::size_t remaining;
+                R next;
+
+                template <typename A, typename X>
+                bool step(A &acc, X &&x) {
+                    if (remaining != 0) {
+                        --remaining;
+                        return true;
+                    }
+                    return next.step(acc, std::forward<X>(x));
+                }
+
+                template <typename A>
+                void complete(A &acc) {
+                    next.complete(acc);
+                }
+            };
+
+            std::size_t n;
+
+            explicit dropping(std::size_t count) : n(count) {}
+
+            template <typename X, typename R>
+            reducer<R> apply(R next) const {
+                return reducer<R>{n, std::move(next)};
+            }
+        };
+
+        inline dropping drop(std::size_t n) { return dropping(n); }
+
+        /**
+         * dedupe: the elements different from the previous one.
+         */
+        struct deduping : transducer_tag {
+            static constexpr bool stateless = false;
+
+            template <typename X>
+            using result_type = X;
+
+            template <typename X, typename R>
+            struct reducer {
+                R next;
+                bool seen;
+                X last;
+
+                template <typename A, typename Y>
+                bool step(A &acc, Y &&x) {
+                    if (seen && last == x) {
+                        return true;
+                    }
+                    seen = true;
+                    last = x;
+                    return next.step(acc, std::forward<Y>(x));
+                }
+
+                template <typename A>
+                void complete(A &acc) {
+                    next.complete(acc);
+                }
+            };
+
+            template <typename X, typename R>
+            reducer<X, R> apply(R next) const {
+                return reducer<X, R>{std::move(next), false, X()};
+            }
+        };
+
+        inline deduping dedupe() { return deduping(); }
+
+        /**
+         * chunk n: the elements grouped by `n`, the last group may be shorter.
+         * Groups are given as `array_view<const X>` of a buffer allocated once
+         * per fold, they are valid until the next step.
+         */
+        struct chunking : transducer_tag {
+            static constexpr bool stateless = false;
+
+            template <typename X>
+            using result_type = array_view<const X>;
+
+            template <typename X, typename R>
+            struct reducer {
+                std::size_t n;
+                std::vector<X> buffer;
+                R next;
+
+                template <typename A, typename Y>
+                bool step(A &acc, Y &&x) {
+                    buffer.push_back(std::forward<Y>(x));
+                    if (buffer.size() < n) {
+                        return true;
+                    }
+                    bool more = next.step(acc, array_view<const X>(buffer.data(), buffer.size()));
+                    buffer.clear();
+                    return more;
+                }
+
+                template <typename A>
+                void complete(A &acc) {
+                    if (!buffer.empty()) {
+                        next.step(acc, array_view<const X>(buffer.data(), buffer.size()));
+                        buffer.clear();
+                    }
+                    next.complete(acc);
+                }
+            };
+
+            std::size_t n;
+
+            explicit chunking(std::size_t size) : n(size == 0 ? 1 : size) {}
+
+            template <typename X, typename R>
+            reducer<X, R> apply(R next) const {
+                reducer<X, R> r{n, std::vector<X>(), std::move(next)};
+                r.buffer.reserve(n);
+                return r;
+            }
+        };
+
+        inline chunking chunk(std::size_t n) { return chunking(n); }
+
+        /**
+         * Composition: the elements go through `A`, then through `B`.
+         */
+        template <typename A, typename B>
+        struct composed : transducer_tag {
+            static constexpr bool stateless = A::stateless && B::stateless;
+
+            template <typename X>
+            using result_type =
+                    typename B::template result_type<typename A::template result_type<X>>;
+
+            A a;
+            B b;
+
+            composed(A first, B second) : a(std::move(first)), b(std::move(second)) {}
+
+            template <typename X, typename R>
+            auto apply(R next) const {
+                return a.template apply<X>(
+                        b.template apply<typename A::template result_type<X>>(std::move(next)));
+            }
+        };
+
+        template <typename A, typename B,
+                  typename = Requires<Transducer<A>::value && Transducer<B>::value>>
+        composed<PlainType<A>, PlainType<B>> operator|(A &&a, B &&b) {
+            return composed<PlainType<A>, PlainType<B>>(std::forward<A>(a), std::forward<B>(b));
+        }
+    };
+
+    /**
+     * Folds driven by a transducer.
+     */
+
+    // Reduce the transformed elements with `fn(acc, x) -> acc`, from `z`.
+    template <typename Xf, typename Fn, typename B, typename F,
+              typename = Requires<Transducer<Xf>::value>>
+    B transduce(const Xf &xf, Fn &&fn, B z, const F &f) {
+        _inner_impl::run_transducer<_inner_impl::element_type<F>>(
+                xf, z,
+                [&fn](B acc, auto &&x) { return fn(std::move(acc), std::forward<decltype(x)>(x)); },
+                f);
+        return z;
+    }
+
+    // `foldMap` of the transformed elements.
+    template <typename Xf, typename Fn, typename F, typename X = _inner_impl::element_type<F>,
+              typename M = ResultOf<Fn(typename PlainType<Xf>::template result_type<X>)>,
+              typename = Requires<Transducer<Xf>::value && Monoid<M>::value>>
+    M foldMap(const Xf &xf, Fn &&fn, const F &f) {
+        M acc = monoid<M>::mempty();
+        _inner_impl::run_transducer<X>(xf, acc, _inner_impl::mappending<M, Fn>{fn}, f);
+        return acc;
+    }
+
+    // `parallel_foldMap` of the transformed elements. Only stateless transducers
+    // (`map`, `filter` and their compositions) can be split across threads. The
+    // reducer is built once per chunk, not per element.
+    template <typename Xf, typename Fn, typename F, typename X = _inner_impl::element_type<F>,
+              typename M = ResultOf<Fn(typename PlainType<Xf>::template result_type<X>)>,
+              typename = Requires<Transducer<Xf>::value && Monoid<M>::value>>
+    M parallel_foldMap(const Xf &xf, Fn &&fn, const F &f, std::size_t threads = 0,
+                       std::size_t grain = 4096) {
+        static_assert(Xf::stateless, "parallel_foldMap: the transducer is not stateless");
+        auto fold_chunk = [&xf, &fn](auto b, auto e) {
+            M acc = monoid<M>::mempty();
+            auto r = xf.template apply<X>(
+                    _inner_impl::reducing<_inner_impl::mappending<M, Fn>>{{fn}});
+            for (; b != e; ++b) {
+                if (!r.step(acc, *b)) {
+                    break;
+                }
+            }
+            r.complete(acc);
+            return acc;
+        };
+        return _inner_impl::parallel_fold_chunks<M>(f, fold_chunk, threads, grain);
+    }
+};
+
+#endif /* __ALGEBRA_CONTROL_TRANSDUCER_HPP__ */
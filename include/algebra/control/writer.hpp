@@ -0,0 +1,166 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_CONTROL_WRITER_HPP__
+#define __ALGEBRA_CONTROL_WRITER_HPP__
+
+#include <tuple>
+#include <utility>
+#include "../basic/type_concepts.hpp"
+#include "../basic/type_operation.hpp"
+#include "../control/applicative.hpp"
+#include "../control/functor.hpp"
+#include "../control/monad.hpp"
+#include "../data/dlist.hpp"
+#include "../data/monoid.hpp"
+
+/**
+ * Writer monad: a value paired with a log, the logs of sequenced computations
+ * are combined by the `mappend` of the monoid `W`.
+ *
+ * Sequence logs (strings, vectors, lists...) are accumulated in a `dlist`, so
+ * each step costs O(1) however the binds are nested, and the log is built
+ * once, in one buffer, when it is asked for. Other monoids (e.g. `sum_monoid`
+ * as a counter) are combined directly.
+ *
+ * e.g.:
+ *      auto step = [](int x) { return writer<std::string, int>(x + 1, "inc;"); };
+ *      auto w = (writer<std::string, int>(0) >>= step) >>= step;
+ *      // w.value() == 2, w.log() == "inc;inc;"
+ */
+namespace algebra {
+
+    namespace _inner_impl {
+        // Sequence containers are accumulated in a `dlist`.
+        template <typename W>
+        auto test_sequence_log(decltype(std::declval<W &>().insert(
+                std::declval<W &>().end(), std::declval<const W &>().begin(),
+                std::declval<const W &>().end())) *) -> std::true_type;
+        template <typename W>
+        auto test_sequence_log(...) -> std::false_type;
+
+        template <typename W, bool = decltype(test_sequence_log<W>(nullptr))::value>
+        struct writer_buffer {
+            using type = W;
+            static const W &materialize(const W &w) { return w; }
+        };
+
+        template <typename W>
+        struct writer_buffer<W, true> {
+            using type = dlist<W>;
+            static W materialize(const dlist<W> &w) { return w.materialize(); }
+        };
+    };
+
+    template <typename W, typename T>
+    class writer {
+       public:
+        using log_type = W;
+        using value_type = T;
+        using buffer_type = typename _inner_impl::writer_buffer<W>::type;
+
+        // Tag for constructing from an accumulated buffer.
+        struct from_buffer {};
+
+       private:
+        T value_;
+        buffer_type log_;
+
+       public:
+        explicit writer(T value) : value_(std::move(value)), log_(monoid<buffer_type>::mempty()) {}
+
+        writer(T value, W log) : value_(std::move(value)), log_(std::move(log)) {}
+
+        writer(from_buffer, T value, buffer_type log)
+                : value_(std::move(value)), log_(std::move(log)) {}
+
+        const T &value() const & { return value_; }
+        T value() && { return std::move(value_); }
+
+        // The combined log.
+        W log() const { return _inner_impl::writer_buffer<W>::materialize(log_); }
+
+        const buffer_type &buffer() const & { return log_; }
+        buffer_type buffer() && { return std::move(log_); }
+
+        // In Haskell:
+        //      runWriter :: Writer w a -> (a, w)
+        std::pair<T, W> run() const { return std::make_pair(value_, log()); }
+
+        friend bool operator==(const writer &a, const writer &b) {
+            return a.value_ == b.value_ && a.log() == b.log();
+        }
+
+        friend bool operator!=(const writer &a, const writer &b) { return !(a == b); }
+    };
+
+    // In Haskell:
+    //      tell :: w -> Writer w ()
+    template <typename W>
+    writer<PlainType<W>, unit> tell(W &&w) {
+        return writer<PlainType<W>, unit>(unit{}, std::forward<W>(w));
+    }
+
+    // Specialize `Rebind` for `writer`, rebind the value type but keep the log type.
+    template <typename W, typename T>
+    struct parametric_type_traits<writer<W, T>> {
+        using value_type = T;
+
+        template <typename U>
+        using rebind = writer<W, U>;
+    };
+
+    /**
+     * writer as functor.
+     */
+    template <typename W, typename T>
+    struct functor<writer<W, T>> {
+        template <typename U>
+        using _F = writer<W, U>;
+
+        template <typename Fn, typename U = ResultOf<Fn(T)>>
+        static _F<U> fmap(Fn &&fn, const _F<T> &w) {
+            return _F<U>(typename _F<U>::from_buffer{}, fn(w.value()), w.buffer());
+        }
+
+        template <typename Fn, typename U = ResultOf<Fn(T)>>
+        static _F<U> fmap(Fn &&fn, _F<T> &&w) {
+            auto v = fn(std::move(w).value());
+            return _F<U>(typename _F<U>::from_buffer{}, std::move(v), std::move(w).buffer());
+        }
+
+        static constexpr bool instance = true;
+    };
+
+    /**
+     * writer as monad, `pure` has an empty log.
+     */
+    template <typename W, typename T>
+    struct monad<writer<W, T>> : default_monad<writer<W, T>> {
+        template <typename U>
+        using _M = writer<W, U>;
+
+        using buffer_type = typename _M<T>::buffer_type;
+
+        static _M<T> pure(const T &x) { return _M<T>(x); }
+        static _M<T> pure(T &&x) { return _M<T>(std::move(x)); }
+
+        template <typename F, typename R = ResultOf<F(T)>, typename U = ValueType<R>>
+        static _M<U> bind(const _M<T> &m, F &&f) {
+            R r = f(m.value());
+            return _M<U>(typename _M<U>::from_buffer{}, std::move(r).value(),
+                         monoid<buffer_type>::mappend(m.buffer(), std::move(r).buffer()));
+        }
+
+        template <typename F, typename R = ResultOf<F(T)>, typename U = ValueType<R>>
+        static _M<U> bind(_M<T> &&m, F &&f) {
+            R r = f(std::move(m).value());
+            buffer_type log = std::move(m).buffer();
+            return _M<U>(typename _M<U>::from_buffer{}, std::move(r).value(),
+                         monoid<buffer_type>::mappend(std::move(log), std::move(r).buffer()));
+        }
+    };
+};
+
+#endif /* __ALGEBRA_CONTROL_WRITER_HPP__ */
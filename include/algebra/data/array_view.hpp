@@ -0,0 +1,114 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_DATA_ARRAY_VIEW_HPP__
+#define __ALGEBRA_DATA_ARRAY_VIEW_HPP__
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include "../basic/type_concepts.hpp"
+#include "../basic/type_operation.hpp"
+#include "../control/functor.hpp"
+#include "../data/foldable.hpp"
+
+/**
+ * Non-owning view of a contiguous array, e.g., of a `std::vector`, of a C
+ * array or of a memory-mapped file. The viewed memory must outlive the view.
+ *
+ * The view is foldable. `fmap` can't write into the viewed memory, so it
+ * rebinds to `std::vector`, which owns the result.
+ */
+namespace algebra {
+
+    template <typename T>
+    class array_view {
+        T *data_;
+        std::size_t size_;
+
+       public:
+        using value_type = typename std::remove_cv<T>::type;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using iterator = T *;
+        using const_iterator = const T *;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        constexpr array_view() noexcept : data_(nullptr), size_(0) {}
+        constexpr array_view(T *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+        template <std::size_t N>
+        constexpr array_view(T (&a)[N]) noexcept : data_(a), size_(N) {}
+
+        // View of a contiguous container, e.g., `std::vector` and `std::array`.
+        template <typename C, typename = decltype(std::declval<C &>().data()),
+                  typename = Requires<!std::is_same<PlainType<C>, array_view>::value>>
+        array_view(C &c) noexcept : data_(c.data()), size_(c.size()) {}
+
+        constexpr iterator begin() const noexcept { return data_; }
+        constexpr iterator end() const noexcept { return data_ + size_; }
+        reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+        reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+
+        constexpr T *data() const noexcept { return data_; }
+        constexpr std::size_t size() const noexcept { return size_; }
+        constexpr bool empty() const noexcept { return size_ == 0; }
+        constexpr T &operator[](std::size_t i) const noexcept { return data_[i]; }
+
+        // The view of `count` elements starting from `offset`, clamped to this view.
+        array_view subview(std::size_t offset, std::size_t count = std::size_t(-1)) const noexcept {
+            offset = offset < size_ ? offset : size_;
+            count = count < size_ - offset ? count : size_ - offset;
+            return array_view(data_ + offset, count);
+        }
+    };
+
+    template <typename T>
+    array_view<T> make_view(T *data, std::size_t size) noexcept {
+        return array_view<T>(data, size);
+    }
+
+    // Specialize `Rebind` for `array_view`, a mapped view is owned by `std::vector`.
+    template <typename T>
+    struct parametric_type_traits<array_view<T>> {
+        using value_type = typename std::remove_cv<T>::type;
+
+        template <typename U>
+        using rebind = std::vector<U>;
+    };
+
+    /**
+     * array_view as functor, the result is written into a `std::vector`.
+     */
+    template <typename T>
+    struct functor<array_view<T>> {
+        template <typename U>
+        using _F = std::vector<U>;
+
+        template <typename Fn, typename U = ResultOf<Fn(T &)>>
+        static _F<U> fmap(Fn &&fn, const array_view<T> &f) {
+            _F<U> result;
+            result.reserve(f.size());
+            for (auto &e : f) {
+                result.emplace_back(fn(e));
+            }
+            return result;
+        }
+
+        static constexpr bool instance = true;
+    };
+
+    /**
+     * array_view as foldable.
+     */
+    template <typename T>
+    struct foldable<array_view<T>> : default_foldable<array_view<T>> {};
+};
+
+#endif /* __ALGEBRA_DATA_ARRAY_VIEW_HPP__ */
@@ -0,0 +1,132 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_DATA_DLIST_HPP__
+#define __ALGEBRA_DATA_DLIST_HPP__
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "../basic/type_concepts.hpp"
+#include "../basic/type_operation.hpp"
+#include "../data/monoid.hpp"
+#include "../data/stl_container.hpp"
+
+/**
+ * Difference list: a sequence container `W` under construction, where
+ * `mappend` is O(1) however the appends are nested. The pieces are kept in an
+ * immutable tree shared by copies, and are flattened into one buffer of the
+ * exact size by `materialize`.
+ *
+ * In Haskell, `Data.DList`.
+ */
+namespace algebra {
+
+    template <typename W>
+    class dlist {
+        // Nodes are never changed once shared, only when being destroyed.
+        struct node {
+            W leaf;
+            std::shared_ptr<node> left, right;
+            std::size_t size;
+        };
+
+        std::shared_ptr<node> root_;
+
+        explicit dlist(std::shared_ptr<node> root) : root_(std::move(root)) {}
+
+        // Release the nodes iteratively, a long chain of appends would overflow
+        // the stack with recursive destructors.
+        static void release(std::shared_ptr<node> root) {
+            std::vector<std::shared_ptr<node>> stack;
+            stack.push_back(std::move(root));
+            while (!stack.empty()) {
+                std::shared_ptr<node> n = std::move(stack.back());
+                stack.pop_back();
+                if (n && n.use_count() == 1) {
+                    stack.push_back(std::move(n->left));
+                    stack.push_back(std::move(n->right));
+                }
+            }
+        }
+
+       public:
+        using value_type = ValueType<W>;
+        using size_type = std::size_t;
+
+        dlist() = default;
+        dlist(const dlist &) = default;
+        dlist(dlist &&) = default;
+        dlist &operator=(const dlist &) = default;
+        dlist &operator=(dlist &&) = default;
+
+        dlist(W w) {
+            if (!w.empty()) {
+                std::size_t n = w.size();
+                root_ = std::make_shared<node>(node{std::move(w), nullptr, nullptr, n});
+            }
+        }
+
+        ~dlist() {
+            if (root_) {
+                release(std::move(root_));
+            }
+        }
+
+        size_type size() const noexcept { return root_ ? root_->size : 0; }
+        bool empty() const noexcept { return !root_; }
+
+        // Flatten the pieces, in order, into one container.
+        W materialize() const {
+            W out;
+            _inner_impl::try_reserve(out, size());
+            std::vector<const node *> stack;
+            if (root_) {
+                stack.push_back(root_.get());
+            }
+            while (!stack.empty()) {
+                const node *n = stack.back();
+                stack.pop_back();
+                if (n->left) {
+                    stack.push_back(n->right.get());
+                    stack.push_back(n->left.get());
+                } else {
+                    out.insert(std::end(out), std::begin(n->leaf), std::end(n->leaf));
+                }
+            }
+            return out;
+        }
+
+        friend dlist concat(const dlist &a, const dlist &b) {
+            if (a.empty()) {
+                return b;
+            }
+            if (b.empty()) {
+                return a;
+            }
+            return dlist(std::make_shared<node>(node{W{}, a.root_, b.root_, a.size() + b.size()}));
+        }
+
+        friend bool operator==(const dlist &a, const dlist &b) {
+            return a.size() == b.size() && a.materialize() == b.materialize();
+        }
+
+        friend bool operator!=(const dlist &a, const dlist &b) { return !(a == b); }
+    };
+
+    /**
+     * Instance dlist as a monoid type.
+     */
+    template <typename W>
+    struct monoid<dlist<W>> {
+        static constexpr bool instance = true;
+
+        static dlist<W> mempty() { return dlist<W>{}; }
+        static dlist<W> mappend(const dlist<W> &a, const dlist<W> &b) { return concat(a, b); }
+    };
+};
+
+#endif /* __ALGEBRA_DATA_DLIST_HPP__ */
@@ -0,0 +1,235 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_DATA_FIXED_LIST_HPP__
+#define __ALGEBRA_DATA_FIXED_LIST_HPP__
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include "../basic/type_concepts.hpp"
+#include "../basic/type_operation.hpp"
+#include "../control/functor.hpp"
+#include "../control/monad.hpp"
+#include "../data/foldable.hpp"
+
+/**
+ * A list of at most `N` elements stored inline, usable in constant
+ * expressions: the list monad over `std::array`, whose size can't vary.
+ *
+ * `bind` over a `fixed_list<T, N>` with a callback giving `fixed_list<U, K>`
+ * results in a `fixed_list<U, N * K>`, so the capacity is known at compile
+ * time and the whole computation can be `constexpr`. Exceeding the capacity
+ * throws `std::length_error`, which is a compile error in constant
+ * expressions.
+ *
+ * The elements must be default constructible literal types. Before C++17
+ * lambdas are not `constexpr`, compile time callbacks are then function
+ * objects with a `constexpr` call operator or pointers to `constexpr`
+ * functions. The operators `%` and `>>=` are traced at runtime, use the
+ * static functions of the instances in constant expressions.
+ */
+namespace algebra {
+
+    template <typename T, std::size_t N>
+    class fixed_list {
+       public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using iterator = T *;
+        using const_iterator = const T *;
+
+       private:
+        T data_[N == 0 ? 1 : N]{};
+        size_type size_ = 0;
+
+       public:
+        constexpr fixed_list() = default;
+
+        constexpr fixed_list(std::initializer_list<T> xs) {
+            for (auto &x : xs) {
+                push_back(x);
+            }
+        }
+
+        template <std::size_t M>
+        constexpr fixed_list(const std::array<T, M> &xs) {
+            static_assert(M <= N, "fixed_list: the array exceeds the capacity");
+            for (size_type i = 0; i < M; ++i) {
+                data_[i] = xs[i];
+            }
+            size_ = M;
+        }
+
+        static constexpr size_type capacity() noexcept { return N; }
+
+        constexpr size_type size() const noexcept { return size_; }
+
+        constexpr bool empty() const noexcept { return size_ == 0; }
+
+        constexpr iterator begin() noexcept { return data_; }
+        constexpr const_iterator begin() const noexcept { return data_; }
+        constexpr iterator end() noexcept { return data_ + size_; }
+        constexpr const_iterator end() const noexcept { return data_ + size_; }
+
+        constexpr reference operator[](size_type i) noexcept { return data_[i]; }
+        constexpr const_reference operator[](size_type i) const noexcept { return data_[i]; }
+
+        constexpr void push_back(const T &x) {
+            if (size_ == N) {
+                throw std::length_error("fixed_list: capacity exceeded");
+            }
+            data_[size_++] = x;
+        }
+
+        constexpr void push_back(T &&x) {
+            if (size_ == N) {
+                throw std::length_error("fixed_list: capacity exceeded");
+            }
+            data_[size_++] = std::move(x);
+        }
+
+        // Lists of any capacity compare by their elements.
+        template <std::size_t M>
+        constexpr bool operator==(const fixed_list<T, M> &other) const {
+            if (size_ != other.size()) {
+                return false;
+            }
+            for (size_type i = 0; i < size_; ++i) {
+                if (!(data_[i] == other[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template <std::size_t M>
+        constexpr bool operator!=(const fixed_list<T, M> &other) const {
+            return !(*this == other);
+        }
+    };
+
+    // Specialize `Rebind` for `fixed_list`, the capacity is kept.
+    template <typename T, std::size_t N>
+    struct parametric_type_traits<fixed_list<T, N>> {
+        using value_type = T;
+
+        template <typename U>
+        using rebind = fixed_list<U, N>;
+    };
+
+    /**
+     * fixed_list as functor.
+     */
+    template <typename T, std::size_t N>
+    struct functor<fixed_list<T, N>> {
+        template <typename Fn, typename U = ResultOf<Fn(T)>>
+        static constexpr fixed_list<U, N> fmap(Fn &&fn, const fixed_list<T, N> &f) {
+            fixed_list<U, N> result;
+            for (auto &e : f) {
+                result.push_back(fn(e));
+            }
+            return result;
+        }
+
+        static constexpr bool instance = true;
+    };
+
+    /**
+     * fixed_list as monad, the result of `bind` has room for every element of
+     * every callback result.
+     */
+    template <typename T, std::size_t N>
+    struct monad<fixed_list<T, N>> {
+       private:
+        template <typename R>
+        struct capacity_of;
+
+        template <typename U, std::size_t K>
+        struct capacity_of<fixed_list<U, K>> {
+            static constexpr std::size_t value = K;
+        };
+
+       public:
+        static constexpr fixed_list<T, N> pure(const T &x) { return fixed_list<T, N>{x}; }
+
+        template <typename F, typename R = ResultOf<F(T)>, typename U = ValueType<R>,
+                  std::size_t K = capacity_of<R>::value>
+        static constexpr fixed_list<U, N * K> bind(const fixed_list<T, N> &m, F &&f) {
+            fixed_list<U, N * K> result;
+            for (auto &e : m) {
+                for (auto &x : f(e)) {
+                    result.push_back(x);
+                }
+            }
+            return result;
+        }
+
+        // Called on the inner type, like `join` of the other instances.
+        template <std::size_t M>
+        static constexpr fixed_list<T, M * N> join(const fixed_list<fixed_list<T, N>, M> &m) {
+            fixed_list<T, M * N> result;
+            for (auto &inner : m) {
+                for (auto &x : inner) {
+                    result.push_back(x);
+                }
+            }
+            return result;
+        }
+
+        template <typename U, std::size_t K>
+        static constexpr fixed_list<U, N * K> then(const fixed_list<T, N> &m,
+                                                   const fixed_list<U, K> &mb) {
+            fixed_list<U, N * K> result;
+            for (std::size_t i = 0; i < m.size(); ++i) {
+                for (auto &x : mb) {
+                    result.push_back(x);
+                }
+            }
+            return result;
+        }
+
+        static constexpr bool instance = true;
+    };
+
+    /**
+     * fixed_list as foldable.
+     */
+    template <typename T, std::size_t N>
+    struct foldable<fixed_list<T, N>> {
+        template <typename Fn, typename B>
+        static constexpr B foldr(Fn &&fn, B z, const fixed_list<T, N> &f) {
+            for (std::size_t i = f.size(); i > 0; --i) {
+                z = fn(f[i - 1], std::move(z));
+            }
+            return z;
+        }
+
+        template <typename Fn, typename B>
+        static constexpr B foldl(Fn &&fn, B z, const fixed_list<T, N> &f) {
+            for (auto &e : f) {
+                z = fn(std::move(z), e);
+            }
+            return z;
+        }
+
+        template <typename Fn, typename M = ResultOf<Fn(T)>, typename = Requires<Monoid<M>::value>>
+        static constexpr M foldMap(Fn &&fn, const fixed_list<T, N> &f) {
+            M acc = monoid<M>::mempty();
+            for (auto &e : f) {
+                acc = monoid<M>::mappend(std::move(acc), fn(e));
+            }
+            return acc;
+        }
+
+        static constexpr bool instance = true;
+    };
+};
+
+#endif /* __ALGEBRA_DATA_FIXED_LIST_HPP__ */
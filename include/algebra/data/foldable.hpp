@@ -0,0 +1,201 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_DATA_FOLDABLE_HPP__
+#define __ALGEBRA_DATA_FOLDABLE_HPP__
+
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <vector>
+#include "../basic/type_concepts.hpp"
+#include "../basic/type_operation.hpp"
+#include "../basic/worker_group.hpp"
+#include "../data/monoid.hpp"
+
+/**
+ * Foldable: data structures that can be folded to a summary value.
+ *
+ * Foldable laws:
+ *  + foldMap f = foldr (mappend . f) mempty
+ *  + foldMap f . fmap g = foldMap (f . g), if the type is also a functor.
+ */
+namespace algebra {
+
+    template <typename F>
+    struct foldable {
+        using T = ValueType<F>;
+
+        /**
+         * Minimal complete definition.
+         */
+
+        // Right-associative fold.
+        // In Haskell:
+        //      foldr :: (a -> b -> b) -> b -> t a -> b
+        template <typename Fn, typename B>
+        static B foldr(Fn &&fn, B z, const F &f);
+
+        /**
+         * Other useful methods.
+         */
+
+        // Left-associative fold.
+        // In Haskell:
+        //      foldl :: (b -> a -> b) -> b -> t a -> b
+        template <typename Fn, typename B>
+        static B foldl(Fn &&fn, B z, const F &f);
+
+        // Map each element to a monoid and combine the results.
+        // In Haskell:
+        //      foldMap :: Monoid m => (a -> m) -> t a -> m
+        template <typename Fn, typename M = ResultOf<Fn(T)>>
+        static M foldMap(Fn &&fn, const F &f);
+
+        // Just a generic class.
+        static constexpr bool instance = false;
+    };
+
+    /**
+     * Foldable type predication.
+     */
+    template <typename F>
+    struct Foldable {
+        static constexpr bool value = foldable<F>::instance;
+        constexpr operator bool() const noexcept { return value; }
+    };
+
+    /**
+     * Default foldable for any type that can be traversed by `std::begin` and
+     * `std::end`. `foldr` additionally requires `std::rbegin` and `std::rend`.
+     */
+    template <typename F>
+    struct default_foldable {
+        using T = ValueType<F>;
+
+        template <typename Fn, typename B>
+        static B foldr(Fn &&fn, B z, const F &f) {
+            for (auto it = f.rbegin(); it != f.rend(); ++it) {
+                z = fn(*it, std::move(z));
+            }
+            return z;
+        }
+
+        template <typename Fn, typename B>
+        static B foldl(Fn &&fn, B z, const F &f) {
+            for (auto &&e : f) {
+                z = fn(std::move(z), e);
+            }
+            return z;
+        }
+
+        template <typename Fn, typename M = ResultOf<Fn(T)>,
+                  typename = Requires<Monoid<M>::value>>
+        static M foldMap(Fn &&fn, const F &f) {
+            M acc = monoid<M>::mempty();
+            for (auto &&e : f) {
+                acc = monoid<M>::mappend(std::move(acc), fn(e));
+            }
+            return acc;
+        }
+
+        static constexpr bool instance = true;
+    };
+
+    /**
+     * Free functions dispatch to the foldable instance of the container, and
+     * are `constexpr` when the instance is, e.g., for `std::array`.
+     */
+
+    template <typename Fn, typename B, typename F, typename _F = PlainType<F>,
+              typename = Requires<Foldable<_F>::value>>
+    constexpr B foldr(Fn &&fn, B z, const F &f) {
+        return foldable<_F>::foldr(std::forward<Fn>(fn), std::move(z), f);
+    }
+
+    template <typename Fn, typename B, typename F, typename _F = PlainType<F>,
+              typename = Requires<Foldable<_F>::value>>
+    constexpr B foldl(Fn &&fn, B z, const F &f) {
+        return foldable<_F>::foldl(std::forward<Fn>(fn), std::move(z), f);
+    }
+
+    template <typename Fn, typename F, typename _F = PlainType<F>,
+              typename = Requires<Foldable<_F>::value>>
+    constexpr auto foldMap(Fn &&fn, const F &f)
+            -> decltype(foldable<_F>::foldMap(std::forward<Fn>(fn), f)) {
+        return foldable<_F>::foldMap(std::forward<Fn>(fn), f);
+    }
+
+    namespace _inner_impl {
+        // Folds the range `f` by `fold_chunk(b, e) -> M` on one contiguous chunk
+        // per thread, and combines the partial results in order. Small ranges
+        // are folded on the calling thread.
+        template <typename M, typename F, typename Chunk>
+        M parallel_fold_chunks(const F &f, Chunk &fold_chunk, std::size_t threads,
+                               std::size_t grain) {
+            auto first = std::begin(f);
+            std::size_t n = static_cast<std::size_t>(std::distance(first, std::end(f)));
+            if (threads == 0) {
+                threads = std::thread::hardware_concurrency();
+            }
+            if (grain == 0) {
+                grain = 1;
+            }
+            if (threads > n / grain) {
+                threads = n / grain;
+            }
+            if (threads <= 1) {
+                return fold_chunk(first, std::end(f));
+            }
+
+            std::vector<M> partial(threads, monoid<M>::mempty());
+            worker_group workers(threads - 1);
+            std::size_t chunk = n / threads, rest = n % threads, offset = 0;
+            auto bounds = [&](std::size_t i) {
+                std::size_t len = chunk + (i < rest ? 1 : 0);
+                auto b = std::next(first, offset);
+                offset += len;
+                return std::make_pair(b, std::next(b, len));
+            };
+            for (std::size_t i = 1; i < threads; ++i) {
+                auto r = bounds(i - 1);
+                workers.spawn([&, i, r] { partial[i - 1] = fold_chunk(r.first, r.second); });
+            }
+            auto last = bounds(threads - 1);
+            partial[threads - 1] = fold_chunk(last.first, last.second);
+            workers.join();
+
+            M acc = std::move(partial[0]);
+            for (std::size_t i = 1; i < threads; ++i) {
+                acc = monoid<M>::mappend(std::move(acc), std::move(partial[i]));
+            }
+            return acc;
+        }
+    };
+
+    /**
+     * Parallel `foldMap` over a random access range: the range is split into
+     * one contiguous chunk per thread, the chunks are folded concurrently and
+     * the partial results are combined in order, which is sound as `mappend`
+     * is associative. Small ranges are folded on the calling thread. An
+     * exception of `fn` or `mappend` in any chunk is thrown to the caller.
+     */
+    template <typename Fn, typename F,
+              typename T = typename std::iterator_traits<decltype(std::begin(
+                      std::declval<const F &>()))>::value_type,
+              typename M = ResultOf<Fn(T)>, typename = Requires<Monoid<M>::value>>
+    M parallel_foldMap(Fn &&fn, const F &f, std::size_t threads = 0,
+                       std::size_t grain = 4096) {
+        auto fold_chunk = [&fn](auto b, auto e) {
+            M acc = monoid<M>::mempty();
+            for (; b != e; ++b) {
+                acc = monoid<M>::mappend(std::move(acc), fn(*b));
+            }
+            return acc;
+        };
+        return _inner_impl::parallel_fold_chunks<M>(f, fold_chunk, threads, grain);
+    }
+};
+
+#endif /* __ALGEBRA_DATA_FOLDABLE_HPP__ */
@@ -0,0 +1,185 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_DATA_FUNCTION_HPP__
+#define __ALGEBRA_DATA_FUNCTION_HPP__
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <utility>
+#include "../basic/type_concepts.hpp"
+#include "../basic/type_operation.hpp"
+
+/**
+ * Callable wrappers without heap allocation, as cheaper value types than
+ * `std::function` for containers of functions (e.g., the `fs` in `fs * xs`).
+ *
+ *  + inplace_function<R(Args...), Size>: owning, the callable is stored in a
+ *    buffer of `Size` bytes inside the object, a larger callable, or one
+ *    whose move may throw, is rejected at compile time.
+ *  + function_ref<R(Args...)>: non-owning reference to a callable, which must
+ *    outlive the reference.
+ */
+namespace algebra {
+
+    template <typename Sig, std::size_t Size = 4 * sizeof(void *),
+              std::size_t Align = alignof(std::max_align_t)>
+    class inplace_function;
+
+    template <typename R, typename... Args, std::size_t Size, std::size_t Align>
+    class inplace_function<R(Args...), Size, Align> {
+        // Operations on the type-erased callable.
+        struct vtable {
+            R (*invoke)(void *, Args &&...);
+            void (*copy)(void *, const void *);
+            void (*move)(void *, void *);
+            void (*destroy)(void *);
+        };
+
+        template <typename F>
+        struct vtable_for {
+            static R invoke(void *f, Args &&... args) {
+                return (*static_cast<F *>(f))(std::forward<Args>(args)...);
+            }
+            static void copy(void *to, const void *from) {
+                ::new (to) F(*static_cast<const F *>(from));
+            }
+            static void move(void *to, void *from) noexcept {
+                ::new (to) F(std::move(*static_cast<F *>(from)));
+                static_cast<F *>(from)->~F();
+            }
+            static void destroy(void *f) { static_cast<F *>(f)->~F(); }
+
+            static constexpr vtable value{&invoke, &copy, &move, &destroy};
+        };
+
+        const vtable *vt_;
+        typename std::aligned_storage<Size, Align>::type buffer_;
+
+       public:
+        using result_type = R;
+
+        inplace_function() noexcept : vt_(nullptr) {}
+        inplace_function(std::nullptr_t) noexcept : vt_(nullptr) {}
+
+        template <typename Fn, typename F = PlainType<Fn>,
+                  typename = Requires<!std::is_same<F, inplace_function>::value>,
+                  typename = Requires<std::is_convertible<
+                          decltype(std::declval<F &>()(std::declval<Args>()...)), R>::value ||
+                                      std::is_void<R>::value>>
+        inplace_function(Fn &&fn) : vt_(&vtable_for<F>::value) {
+            static_assert(sizeof(F) <= Size, "callable too large for inplace_function");
+            static_assert(Align % alignof(F) == 0, "callable over-aligned for inplace_function");
+            static_assert(std::is_nothrow_move_constructible<F>::value,
+                          "callable of inplace_function must be nothrow move constructible");
+            ::new (static_cast<void *>(&buffer_)) F(std::forward<Fn>(fn));
+        }
+
+        inplace_function(const inplace_function &other) : vt_(other.vt_) {
+            if (vt_) {
+                vt_->copy(&buffer_, &other.buffer_);
+            }
+        }
+
+        inplace_function(inplace_function &&other) noexcept : vt_(other.vt_) {
+            if (vt_) {
+                vt_->move(&buffer_, &other.buffer_);
+                other.vt_ = nullptr;
+            }
+        }
+
+        ~inplace_function() {
+            if (vt_) {
+                vt_->destroy(&buffer_);
+            }
+        }
+
+        inplace_function &operator=(const inplace_function &other) {
+            if (this != &other) {
+                inplace_function t(other);
+                *this = std::move(t);
+            }
+            return *this;
+        }
+
+        inplace_function &operator=(inplace_function &&other) noexcept {
+            if (this != &other) {
+                if (vt_) {
+                    vt_->destroy(&buffer_);
+                    vt_ = nullptr;
+                }
+                if (other.vt_) {
+                    other.vt_->move(&buffer_, &other.buffer_);
+                    vt_ = other.vt_;
+                    other.vt_ = nullptr;
+                }
+            }
+            return *this;
+        }
+
+        void swap(inplace_function &other) noexcept {
+            inplace_function t(std::move(other));
+            other = std::move(*this);
+            *this = std::move(t);
+        }
+
+        explicit operator bool() const noexcept { return vt_ != nullptr; }
+
+        R operator()(Args... args) const {
+            if (!vt_) {
+                throw std::bad_function_call();
+            }
+            return vt_->invoke(const_cast<void *>(static_cast<const void *>(&buffer_)),
+                               std::forward<Args>(args)...);
+        }
+    };
+
+    template <typename R, typename... Args, std::size_t Size, std::size_t Align>
+    template <typename F>
+    constexpr typename inplace_function<R(Args...), Size, Align>::vtable
+            inplace_function<R(Args...), Size, Align>::vtable_for<F>::value;
+
+    template <typename Sig>
+    class function_ref;
+
+    template <typename R, typename... Args>
+    class function_ref<R(Args...)> {
+        // Functions can't be referred by `void *`, keep them as function pointers.
+        union callable {
+            void *obj;
+            void (*fn)();
+        } callable_;
+        R (*invoke_)(callable, Args &&...);
+
+        template <typename F>
+        static R invoke_obj(callable f, Args &&... args) {
+            return (*static_cast<F *>(f.obj))(std::forward<Args>(args)...);
+        }
+
+        template <typename F>
+        static R invoke_fn(callable f, Args &&... args) {
+            return reinterpret_cast<F *>(f.fn)(std::forward<Args>(args)...);
+        }
+
+       public:
+        using result_type = R;
+
+        template <typename Fn, typename F = typename std::remove_reference<Fn>::type,
+                  typename = Requires<!std::is_same<PlainType<Fn>, function_ref>::value &&
+                                      !std::is_function<F>::value>>
+        function_ref(Fn &&fn) noexcept : invoke_(&invoke_obj<F>) {
+            callable_.obj = const_cast<void *>(static_cast<const void *>(std::addressof(fn)));
+        }
+
+        template <typename R2, typename... Args2>
+        function_ref(R2 (*fn)(Args2...)) noexcept : invoke_(&invoke_fn<R2(Args2...)>) {
+            callable_.fn = reinterpret_cast<void (*)()>(fn);
+        }
+
+        R operator()(Args... args) const { return invoke_(callable_, std::forward<Args>(args)...); }
+    };
+};
+
+#endif /* __ALGEBRA_DATA_FUNCTION_HPP__ */
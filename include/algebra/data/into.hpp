@@ -0,0 +1,323 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_DATA_INTO_HPP__
+#define __ALGEBRA_DATA_INTO_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../basic/instrument.hpp"
+#include "../basic/type_concepts.hpp"
+#include "../basic/type_operation.hpp"
+#include "../control/functor.hpp"
+#include "../data/array_view.hpp"
+#include "../data/foldable.hpp"
+#include "../data/stl_container.hpp"
+
+/**
+ * `fmap`, `bind` and `mappend` writing into caller-owned outputs, so that a
+ * hot loop can reuse the same buffers instead of allocating new containers
+ * at every call:
+ *
+ *  + a container is overwritten: it's cleared and refilled, keeping its
+ *    capacity, which makes the steady state free of allocations,
+ *  + an `array_view` is written from its first element, the result is the
+ *    view of the written elements, exceeding it throws `std::length_error`,
+ *  + any other argument is an output iterator, written through and returned,
+ *    like `std::transform` does.
+ *
+ * The inputs are any ranges: containers, `array_view` or, for an iterator
+ * pair, `iterator_range`. Outputs must not overlap the inputs.
+ *
+ * e.g.:
+ *      std::vector<float> out;
+ *      for (auto &request : requests) {
+ *          fmap_into(scale, make_view(request.data, request.size), out);
+ *          ...
+ *      }
+ */
+namespace algebra {
+
+    /**
+     * Non-owning view of an iterator pair.
+     */
+    template <typename It>
+    class iterator_range {
+        It first_, last_;
+
+       public:
+        using value_type = typename std::iterator_traits<It>::value_type;
+        using iterator = It;
+        using const_iterator = It;
+        using reverse_iterator = std::reverse_iterator<It>;
+
+        iterator_range(It first, It last) : first_(first), last_(last) {}
+
+        It begin() const { return first_; }
+        It end() const { return last_; }
+        reverse_iterator rbegin() const { return reverse_iterator(last_); }
+        reverse_iterator rend() const { return reverse_iterator(first_); }
+        bool empty() const { return first_ == last_; }
+    };
+
+    template <typename It>
+    iterator_range<It> make_range(It first, It last) {
+        return iterator_range<It>(first, last);
+    }
+
+    // Specialize `Rebind` for `iterator_range`, a mapped range is owned by `std::vector`.
+    template <typename It>
+    struct parametric_type_traits<iterator_range<It>> {
+        using value_type = typename std::iterator_traits<It>::value_type;
+
+        template <typename U>
+        using rebind = std::vector<U>;
+    };
+
+    /**
+     * iterator_range as functor, the result is written into a `std::vector`.
+     */
+    template <typename It>
+    struct functor<iterator_range<It>> {
+        using T = typename std::iterator_traits<It>::value_type;
+
+        template <typename U>
+        using _F = std::vector<U>;
+
+        template <typename Fn, typename U = ResultOf<Fn(T)>>
+        static _F<U> fmap(Fn &&fn, const iterator_range<It> &f) {
+            _F<U> result;
+            for (auto &&e : f) {
+                result.emplace_back(fn(e));
+            }
+            return result;
+        }
+
+        static constexpr bool instance = true;
+    };
+
+    /**
+     * iterator_range as foldable.
+     */
+    template <typename It>
+    struct foldable<iterator_range<It>> : default_foldable<iterator_range<It>> {};
+
+    namespace _inner_impl {
+        // Containers that can be cleared and appended to.
+        template <typename C, typename = void>
+        struct is_output_container : std::false_type {};
+
+        template <typename C>
+        struct is_output_container<C, decltype(std::declval<C &>().clear(),
+                                               std::declval<C &>().push_back(
+                                                       std::declval<typename C::value_type>()),
+                                               void())> : std::true_type {};
+
+        template <typename T>
+        struct is_array_view : std::false_type {};
+
+        template <typename T>
+        struct is_array_view<array_view<T>> : std::true_type {};
+
+        template <typename O>
+        using is_output_iterator =
+                std::integral_constant<bool, !is_output_container<PlainType<O>>::value &&
+                                                     !is_array_view<PlainType<O>>::value>;
+
+        // Views don't own their elements, which must not be moved out of them.
+        template <typename R>
+        struct owns_elements : std::integral_constant<bool, !std::is_reference<R>::value> {};
+
+        template <typename T>
+        struct owns_elements<array_view<T>> : std::false_type {};
+
+        template <typename It>
+        struct owns_elements<iterator_range<It>> : std::false_type {};
+
+        template <typename OutIt, typename X>
+        void put_element(OutIt &out, X &x, std::true_type) {
+            *out++ = std::move(x);
+        }
+
+        template <typename OutIt, typename X>
+        void put_element(OutIt &out, X &x, std::false_type) {
+            *out++ = x;
+        }
+
+        // The size of a range when known without traversing it, else 0.
+        template <typename R>
+        auto known_size(const R &r, int) -> decltype(std::size_t(r.size())) {
+            return r.size();
+        }
+
+        template <typename R>
+        std::size_t known_size(const R &, long) {
+            return 0;
+        }
+
+        // Writes into an array, throwing when it's full.
+        template <typename T>
+        class checked_output {
+            T *p_, *end_;
+
+           public:
+            using iterator_category = std::output_iterator_tag;
+            using value_type = void;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = void;
+
+            checked_output(T *p, T *end) : p_(p), end_(end) {}
+
+            template <typename X>
+            checked_output &operator=(X &&x) {
+                if (p_ == end_) {
+                    throw std::length_error("array_view: the output is full");
+                }
+                *p_++ = std::forward<X>(x);
+                return *this;
+            }
+
+            checked_output &operator*() { return *this; }
+            checked_output &operator++() { return *this; }
+            checked_output &operator++(int) { return *this; }
+
+            T *position() const { return p_; }
+        };
+
+        // Vectors of trivial types read from an array use the `fmap` kernel.
+        template <typename C, typename R, typename U = typename C::value_type>
+        using fmap_into_contiguous = std::integral_constant<
+                bool, is_contiguous_vector<C>::value &&
+                              std::is_pointer<decltype(std::declval<const R &>().data())>::value &&
+                              std::is_trivially_copyable<ValueType<R>>::value &&
+                              std::is_trivially_default_constructible<U>::value &&
+                              std::is_trivially_copy_assignable<U>::value>;
+
+        template <typename Fn, typename R, typename C>
+        void fmap_into_container(Fn &fn, const R &input, C &out, std::true_type) {
+            out.clear();
+            map_contiguous(fn, input.data(), input.size(), out);
+        }
+
+        template <typename Fn, typename R, typename C>
+        void fmap_into_container(Fn &fn, const R &input, C &out, std::false_type) {
+            out.clear();
+            try_reserve(out, known_size(input, 0));
+            for (auto &&e : input) {
+                out.push_back(fn(e));
+            }
+        }
+
+        template <typename C, typename R, typename = void>
+        struct fmap_into_dispatch : std::false_type {};
+
+        template <typename C, typename R>
+        struct fmap_into_dispatch<C, R, decltype(std::declval<const R &>().data(), void())>
+                : fmap_into_contiguous<C, R> {};
+    };
+
+    /**
+     * fmap_into: `fmap fn input`, into `out`.
+     */
+
+    template <typename Fn, typename R, typename OutIt,
+              typename = Requires<_inner_impl::is_output_iterator<OutIt>::value>>
+    OutIt fmap_into(Fn &&fn, const R &input, OutIt out) {
+        ALGEBRA_INSTRUMENT_SCOPE(fmap);
+        for (auto &&e : input) {
+            *out++ = fn(e);
+        }
+        return out;
+    }
+
+    template <typename Fn, typename R, typename C,
+              typename = Requires<_inner_impl::is_output_container<C>::value>>
+    C &fmap_into(Fn &&fn, const R &input, C &out) {
+        ALGEBRA_INSTRUMENT_SCOPE(fmap);
+        _inner_impl::fmap_into_container(fn, input, out,
+                                         _inner_impl::fmap_into_dispatch<C, R>{});
+        return out;
+    }
+
+    template <typename Fn, typename R, typename T>
+    array_view<T> fmap_into(Fn &&fn, const R &input, array_view<T> out) {
+        auto end = fmap_into(std::forward<Fn>(fn), input,
+                             _inner_impl::checked_output<T>(out.begin(), out.end()));
+        return out.subview(0, static_cast<std::size_t>(end.position() - out.begin()));
+    }
+
+    /**
+     * bind_into: `input >>= f`, into `out`. The results of `f` can be any
+     * range, e.g., `fixed_list` or `array_view`, so that no intermediate
+     * container is allocated either. Elements of results returned by value
+     * are moved, the others are copied.
+     */
+
+    template <typename R, typename F, typename OutIt,
+              typename = Requires<_inner_impl::is_output_iterator<OutIt>::value>>
+    OutIt bind_into(const R &input, F &&f, OutIt out) {
+        ALGEBRA_INSTRUMENT_SCOPE(bind);
+        for (auto &&e : input) {
+            using Result = decltype(f(e));
+            auto &&r = f(e);
+            for (auto &x : r) {
+                _inner_impl::put_element(out, x, _inner_impl::owns_elements<Result>{});
+            }
+        }
+        return out;
+    }
+
+    template <typename R, typename F, typename C,
+              typename = Requires<_inner_impl::is_output_container<C>::value>>
+    C &bind_into(const R &input, F &&f, C &out) {
+        out.clear();
+        bind_into(input, std::forward<F>(f), std::back_inserter(out));
+        return out;
+    }
+
+    template <typename R, typename F, typename T>
+    array_view<T> bind_into(const R &input, F &&f, array_view<T> out) {
+        auto end = bind_into(input, std::forward<F>(f),
+                             _inner_impl::checked_output<T>(out.begin(), out.end()));
+        return out.subview(0, static_cast<std::size_t>(end.position() - out.begin()));
+    }
+
+    /**
+     * mappend_into: `l1 <> l2`, into `out`.
+     */
+
+    template <typename R1, typename R2, typename OutIt,
+              typename = Requires<_inner_impl::is_output_iterator<OutIt>::value>>
+    OutIt mappend_into(const R1 &l1, const R2 &l2, OutIt out) {
+        ALGEBRA_INSTRUMENT_SCOPE(mappend);
+        out = std::copy(std::begin(l1), std::end(l1), out);
+        return std::copy(std::begin(l2), std::end(l2), out);
+    }
+
+    template <typename R1, typename R2, typename C,
+              typename = Requires<_inner_impl::is_output_container<C>::value>>
+    C &mappend_into(const R1 &l1, const R2 &l2, C &out) {
+        ALGEBRA_INSTRUMENT_SCOPE(mappend);
+        out.clear();
+        _inner_impl::try_reserve(out, _inner_impl::known_size(l1, 0) +
+                                              _inner_impl::known_size(l2, 0));
+        out.insert(std::end(out), std::begin(l1), std::end(l1));
+        out.insert(std::end(out), std::begin(l2), std::end(l2));
+        return out;
+    }
+
+    template <typename R1, typename R2, typename T>
+    array_view<T> mappend_into(const R1 &l1, const R2 &l2, array_view<T> out) {
+        auto end = mappend_into(l1, l2, _inner_impl::checked_output<T>(out.begin(), out.end()));
+        return out.subview(0, static_cast<std::size_t>(end.position() - out.begin()));
+    }
+};
+
+#endif /* __ALGEBRA_DATA_INTO_HPP__ */
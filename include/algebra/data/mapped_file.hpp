@@ -0,0 +1,211 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_DATA_MAPPED_FILE_HPP__
+#define __ALGEBRA_DATA_MAPPED_FILE_HPP__
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include "../data/array_view.hpp"
+
+/**
+ * Read-only memory mapping of a whole file (POSIX only). The records of the
+ * file are accessed through `view<T>()`, an `array_view` which can be folded
+ * (also in parallel, see `parallel_foldMap`) and mapped without copying the
+ * file into memory first.
+ *
+ * e.g.:
+ *      mapped_file file("records.bin");
+ *      auto total = parallel_foldMap(sum<std::int64_t>, file.view<std::int64_t>());
+ */
+namespace algebra {
+
+    class mapped_file {
+       public:
+        // Access pattern hints, passed to `madvise`.
+        enum class advice { normal, sequential, random, willneed, dontneed };
+
+       private:
+        void *data_ = nullptr;
+        std::size_t size_ = 0;
+        // The length of the mapping, whole pages, or whole huge pages which
+        // includes the reserved tail of an aligned mapping.
+        std::size_t length_ = 0;
+
+        static constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+        static int to_madvise(advice a) noexcept {
+            switch (a) {
+                case advice::sequential:
+                    return MADV_SEQUENTIAL;
+                case advice::random:
+                    return MADV_RANDOM;
+                case advice::willneed:
+                    return MADV_WILLNEED;
+                case advice::dontneed:
+                    return MADV_DONTNEED;
+                default:
+                    return MADV_NORMAL;
+            }
+        }
+
+        [[noreturn]] static void fail(const std::string &what) {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        static std::size_t round_up(std::size_t size, std::size_t unit) noexcept {
+            return (size + unit - 1) / unit * unit;
+        }
+
+        // Find an address aligned to the huge page size with room for `length`
+        // bytes, a multiple of the huge page size, by reserving a larger
+        // anonymous region and trimming it. The region is left reserved, to be
+        // replaced by a `MAP_FIXED` mapping.
+        static void *reserve_aligned(std::size_t length) noexcept {
+            std::size_t span = length + huge_page_size;
+            void *p = ::mmap(nullptr, span, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) {
+                return nullptr;
+            }
+            auto begin = reinterpret_cast<std::uintptr_t>(p);
+            auto aligned = (begin + huge_page_size - 1) & ~(huge_page_size - 1);
+            bool trimmed = true;
+            if (aligned > begin) {
+                trimmed = ::munmap(p, aligned - begin) == 0;
+            }
+            if (trimmed && begin + span > aligned + length) {
+                trimmed = ::munmap(reinterpret_cast<void *>(aligned + length),
+                                   begin + span - aligned - length) == 0;
+            }
+            if (!trimmed) {
+                ::munmap(p, span);
+                return nullptr;
+            }
+            return reinterpret_cast<void *>(aligned);
+        }
+
+       public:
+        mapped_file() = default;
+
+        // Map the whole file `path`. With `huge_pages` the mapping is aligned to
+        // the huge page size and transparent huge pages are requested, where the
+        // system supports them.
+        explicit mapped_file(const std::string &path, advice a = advice::sequential,
+                             bool huge_pages = false) {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                fail("open " + path);
+            }
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                int e = errno;
+                ::close(fd);
+                errno = e;
+                fail("fstat " + path);
+            }
+            size_ = static_cast<std::size_t>(st.st_size);
+            if (size_ != 0) {
+                std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+                length_ = round_up(size_, page);
+                void *hint = nullptr;
+                if (huge_pages) {
+                    hint = reserve_aligned(round_up(size_, huge_page_size));
+                    if (hint) {
+                        length_ = round_up(size_, huge_page_size);
+                    }
+                }
+                int flags = MAP_PRIVATE | (hint ? MAP_FIXED : 0);
+                data_ = ::mmap(hint, size_, PROT_READ, flags, fd, 0);
+                if (data_ == MAP_FAILED) {
+                    int e = errno;
+                    if (hint) {
+                        ::munmap(hint, length_);
+                    }
+                    data_ = nullptr;
+                    size_ = length_ = 0;
+                    ::close(fd);
+                    errno = e;
+                    fail("mmap " + path);
+                }
+#ifdef MADV_HUGEPAGE
+                if (huge_pages) {
+                    ::madvise(data_, size_, MADV_HUGEPAGE);
+                }
+#endif
+                advise(a);
+            }
+            ::close(fd);
+        }
+
+        mapped_file(const mapped_file &) = delete;
+        mapped_file &operator=(const mapped_file &) = delete;
+
+        mapped_file(mapped_file &&other) noexcept
+                : data_(other.data_), size_(other.size_), length_(other.length_) {
+            other.data_ = nullptr;
+            other.size_ = other.length_ = 0;
+        }
+
+        mapped_file &operator=(mapped_file &&other) noexcept {
+            if (this != &other) {
+                unmap();
+                data_ = other.data_;
+                size_ = other.size_;
+                length_ = other.length_;
+                other.data_ = nullptr;
+                other.size_ = other.length_ = 0;
+            }
+            return *this;
+        }
+
+        ~mapped_file() { unmap(); }
+
+        // Release the mapping, with the reserved tail of an aligned mapping.
+        // False if `munmap` failed.
+        bool unmap() noexcept {
+            bool released = true;
+            if (data_) {
+                released = ::munmap(data_, length_) == 0;
+                data_ = nullptr;
+                size_ = length_ = 0;
+            }
+            return released;
+        }
+
+        // Give an access pattern hint for the whole mapping, or for a byte range.
+        void advise(advice a, std::size_t offset = 0, std::size_t length = std::size_t(-1)) const {
+            if (!data_ || offset >= size_) {
+                return;
+            }
+            // `madvise` requires a page aligned address.
+            std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            std::size_t begin = offset / page * page;
+            length = length < size_ - offset ? length : size_ - offset;
+            ::madvise(static_cast<char *>(data_) + begin, offset + length - begin, to_madvise(a));
+        }
+
+        const void *data() const noexcept { return data_; }
+        std::size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+
+        // The file as an array of fixed-size records, a trailing partial record
+        // is not part of the view.
+        template <typename T>
+        array_view<const T> view() const noexcept {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "records of a mapped file must be trivially copyable");
+            return array_view<const T>(static_cast<const T *>(data_), size_ / sizeof(T));
+        }
+    };
+};
+
+#endif /* __ALGEBRA_DATA_MAPPED_FILE_HPP__ */
@@ -0,0 +1,313 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_DATA_MATRIX_HPP__
+#define __ALGEBRA_DATA_MATRIX_HPP__
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../basic/instrument.hpp"
+#include "../basic/type_concepts.hpp"
+#include "../basic/type_operation.hpp"
+#include "../basic/worker_group.hpp"
+#include "../data/monoid.hpp"
+
+/**
+ * Dense matrices over a semiring, a monoid under the product of matrices:
+ * powers of a matrix by `stimes` give the paths of every length in a graph
+ * (boolean), the shortest paths (tropical) or the transitions of a Markov
+ * chain after many steps (ordinary arithmetic).
+ *
+ * e.g.:
+ *      matrix<min_plus<double>> w(n, n);   // infinite distances,
+ *      w(i, j) = ...;                      // but along the edges, and 0 from
+ *      w(i, i) = 0;                        // every node to itself
+ *      auto shortest = stimes(n - 1, w);   // then the shortest paths
+ *
+ * A semiring `S` has a `value_type` and the static functions `zero()`, `one()`,
+ * `add(a, b)` and `mul(a, b)`. The product is computed by a cache-blocked
+ * kernel: panels of the right operand that fit the caches, and tiles of the
+ * result accumulated in registers, whose loops compilers vectorize. Large
+ * products are split by rows over threads.
+ *
+ * The default constructed matrix is the identity of any size, `mempty`.
+ */
+namespace algebra {
+
+    /**
+     * Semirings.
+     */
+
+    // (+, ×), the ordinary arithmetic.
+    template <typename T>
+    struct plus_times {
+        using value_type = T;
+
+        static constexpr T zero() noexcept { return T(0); }
+        static constexpr T one() noexcept { return T(1); }
+        static constexpr T add(T a, T b) noexcept { return a + b; }
+        static constexpr T mul(T a, T b) noexcept { return a * b; }
+    };
+
+    // (min, +), the tropical semiring of shortest paths. Zero is the infinity,
+    // or the maximum of integers, which absorbs the additions.
+    template <typename T>
+    struct min_plus {
+        using value_type = T;
+
+        static constexpr T zero() noexcept {
+            return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                        : std::numeric_limits<T>::max();
+        }
+        static constexpr T one() noexcept { return T(0); }
+        static constexpr T add(T a, T b) noexcept { return b < a ? b : a; }
+        static constexpr T mul(T a, T b) noexcept {
+            return std::numeric_limits<T>::has_infinity || (a != zero() && b != zero()) ? a + b
+                                                                                        : zero();
+        }
+    };
+
+    // (or, and), the boolean semiring of reachability. The values are bytes
+    // of 0 or 1, so that matrices are arrays.
+    struct or_and {
+        using value_type = std::uint8_t;
+
+        static constexpr value_type zero() noexcept { return 0; }
+        static constexpr value_type one() noexcept { return 1; }
+        static constexpr value_type add(value_type a, value_type b) noexcept {
+            return value_type(a | b);
+        }
+        static constexpr value_type mul(value_type a, value_type b) noexcept {
+            return value_type(a & b);
+        }
+    };
+
+    template <typename S>
+    class matrix {
+       public:
+        using semiring = S;
+        using value_type = typename S::value_type;
+        using size_type = std::size_t;
+
+       private:
+        size_type rows_ = 0, cols_ = 0;
+        bool unit_ = true;
+        std::vector<value_type> data_;
+
+       public:
+        // The identity of any size.
+        matrix() = default;
+
+        // A matrix filled with zeros.
+        matrix(size_type rows, size_type cols)
+                : rows_(rows), cols_(cols), unit_(false), data_(rows * cols, S::zero()) {}
+
+        // A matrix from its elements, row by row.
+        matrix(size_type rows, size_type cols, std::initializer_list<value_type> xs)
+                : rows_(rows), cols_(cols), unit_(false), data_(xs) {
+            if (data_.size() != rows * cols) {
+                throw std::invalid_argument("matrix: wrong number of elements");
+            }
+        }
+
+        static matrix identity(size_type n) {
+            matrix m(n, n);
+            for (size_type i = 0; i < n; ++i) {
+                m(i, i) = S::one();
+            }
+            return m;
+        }
+
+        // Whether the matrix is the identity of any size.
+        bool unit() const noexcept { return unit_; }
+
+        size_type rows() const noexcept { return rows_; }
+        size_type cols() const noexcept { return cols_; }
+
+        value_type *data() noexcept { return data_.data(); }
+        const value_type *data() const noexcept { return data_.data(); }
+
+        // The identity of any size has no elements.
+        value_type &operator()(size_type i, size_type j) noexcept {
+            assert(!unit_ && i < rows_ && j < cols_);
+            return data_[i * cols_ + j];
+        }
+        const value_type &operator()(size_type i, size_type j) const noexcept {
+            assert(!unit_ && i < rows_ && j < cols_);
+            return data_[i * cols_ + j];
+        }
+
+        bool operator==(const matrix &other) const {
+            return unit_ == other.unit_ && rows_ == other.rows_ && cols_ == other.cols_ &&
+                   data_ == other.data_;
+        }
+        bool operator!=(const matrix &other) const { return !(*this == other); }
+    };
+
+    namespace _inner_impl {
+        // The sizes of the blocks: `kc` rows of the right operand by `nc`
+        // columns stay in the L2 cache, tiles of the result of `mr` rows by
+        // `nr` columns (64 bytes a row) are accumulated in registers.
+        template <typename T>
+        struct gemm_blocking {
+            static constexpr std::size_t mr = 4;
+            static constexpr std::size_t nr = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+            static constexpr std::size_t kc = 256;
+            static constexpr std::size_t nc = 64 * nr;
+        };
+
+        // c[0, mr)[0, nr) = c + a[0, mr)[0, kc) * b[0, kc)[0, nr), in registers.
+        template <typename S, std::size_t MR, std::size_t NR, typename T>
+        void gemm_tile(const T *a, std::size_t lda, const T *b, std::size_t ldb, T *c,
+                       std::size_t ldc, std::size_t kc) {
+            T acc[MR][NR];
+            for (std::size_t r = 0; r < MR; ++r) {
+                for (std::size_t j = 0; j < NR; ++j) {
+                    acc[r][j] = c[r * ldc + j];
+                }
+            }
+            for (std::size_t k = 0; k < kc; ++k) {
+                const T *bk = b + k * ldb;
+                for (std::size_t r = 0; r < MR; ++r) {
+                    T ar = a[r * lda + k];
+                    for (std::size_t j = 0; j < NR; ++j) {
+                        acc[r][j] = S::add(acc[r][j], S::mul(ar, bk[j]));
+                    }
+                }
+            }
+            for (std::size_t r = 0; r < MR; ++r) {
+                for (std::size_t j = 0; j < NR; ++j) {
+                    c[r * ldc + j] = acc[r][j];
+                }
+            }
+        }
+
+        // The same for the tiles at the edges, smaller than a full tile.
+        template <typename S, typename T>
+        void gemm_edge(const T *a, std::size_t lda, const T *b, std::size_t ldb, T *c,
+                       std::size_t ldc, std::size_t mr, std::size_t nr, std::size_t kc) {
+            for (std::size_t r = 0; r < mr; ++r) {
+                for (std::size_t k = 0; k < kc; ++k) {
+                    T ar = a[r * lda + k];
+                    const T *bk = b + k * ldb;
+                    T *cr = c + r * ldc;
+                    for (std::size_t j = 0; j < nr; ++j) {
+                        cr[j] = S::add(cr[j], S::mul(ar, bk[j]));
+                    }
+                }
+            }
+        }
+
+        // Rows [first, last) of c (m x p) = c + a (m x n) * b (n x p).
+        template <typename S, typename T>
+        void gemm_rows(const T *a, const T *b, T *c, std::size_t n, std::size_t p,
+                       std::size_t first, std::size_t last) {
+            using blocking = gemm_blocking<T>;
+            constexpr std::size_t mr = blocking::mr, nr = blocking::nr;
+            constexpr std::size_t kcmax = blocking::kc, nc = blocking::nc;
+            for (std::size_t k0 = 0; k0 < n; k0 += kcmax) {
+                std::size_t kc = std::min(kcmax, n - k0);
+                for (std::size_t j0 = 0; j0 < p; j0 += nc) {
+                    std::size_t j1 = std::min(p, j0 + nc);
+                    for (std::size_t i = first; i < last; i += mr) {
+                        std::size_t rows = std::min(mr, last - i);
+                        const T *ai = a + i * n + k0;
+                        for (std::size_t j = j0; j < j1; j += nr) {
+                            std::size_t cols = std::min(nr, j1 - j);
+                            const T *bj = b + k0 * p + j;
+                            T *cij = c + i * p + j;
+                            if (rows == mr && cols == nr) {
+                                gemm_tile<S, mr, nr>(ai, n, bj, p, cij, p, kc);
+                            } else {
+                                gemm_edge<S>(ai, n, bj, p, cij, p, rows, cols, kc);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    /**
+     * The product of matrices over the semiring `S`, on `threads` threads,
+     * all the cores if 0. Products of less than a million operations are
+     * computed by the calling thread.
+     */
+    template <typename S>
+    matrix<S> multiply(const matrix<S> &a, const matrix<S> &b, std::size_t threads = 0) {
+        ALGEBRA_INSTRUMENT_SCOPE(mappend);
+        if (a.unit()) {
+            return b;
+        }
+        if (b.unit()) {
+            return a;
+        }
+        if (a.cols() != b.rows()) {
+            throw std::invalid_argument("matrix: the sizes don't match");
+        }
+        using T = typename S::value_type;
+        constexpr std::size_t mr = _inner_impl::gemm_blocking<T>::mr;
+        std::size_t m = a.rows(), n = a.cols(), p = b.cols();
+        matrix<S> c(m, p);
+        if (threads == 0) {
+            threads = std::thread::hardware_concurrency();
+        }
+        std::size_t work = m * n * p, tiles = (m + mr - 1) / mr;
+        threads = std::min(std::max<std::size_t>(1, work >> 20), std::max<std::size_t>(1, threads));
+        threads = std::min(threads, tiles);
+        if (threads <= 1) {
+            _inner_impl::gemm_rows<S>(a.data(), b.data(), c.data(), n, p, 0, m);
+            return c;
+        }
+        // Whole tiles of rows for every thread, the caller takes the last range.
+        _inner_impl::worker_group workers(threads - 1);
+        std::size_t first = 0;
+        for (std::size_t t = 0; t < threads; ++t) {
+            std::size_t last = std::min(m, (tiles * (t + 1) / threads) * mr);
+            if (t + 1 == threads) {
+                _inner_impl::gemm_rows<S>(a.data(), b.data(), c.data(), n, p, first, last);
+            } else {
+                workers.spawn([&, first, last] {
+                    _inner_impl::gemm_rows<S>(a.data(), b.data(), c.data(), n, p, first, last);
+                });
+            }
+            first = last;
+        }
+        workers.join();
+        return c;
+    }
+
+    /**
+     * Matrices as monoid, under the product.
+     */
+    template <typename S>
+    struct monoid<matrix<S>> {
+        static constexpr bool instance = true;
+
+        static matrix<S> mempty() { return matrix<S>(); }
+
+        static matrix<S> mappend(const matrix<S> &a, const matrix<S> &b) { return multiply(a, b); }
+
+        // m^n by repeated squaring, m^0 is the identity of the size of m.
+        static matrix<S> stimes(std::size_t n, const matrix<S> &m) {
+            if (n != 0 || m.unit()) {
+                return _inner_impl::stimes_by_squaring(n, m);
+            }
+            if (m.rows() != m.cols()) {
+                throw std::invalid_argument("matrix: powers of a matrix that isn't square");
+            }
+            return matrix<S>::identity(m.rows());
+        }
+    };
+};
+
+#endif /* __ALGEBRA_DATA_MATRIX_HPP__ */
@@ -5,6 +5,12 @@
 #ifndef __ALGEBRA_DATA_MONOID_HPP__
 #define __ALGEBRA_DATA_MONOID_HPP__
 
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include "../basic/trace.hpp"
 #include "../basic/type_concepts.hpp"
 #include "../basic/type_operation.hpp"
 
@@ -41,7 +47,89 @@ namespace algebra {
     template <typename MA, typename MB, typename M = PlainType<MA>,
               typename = Requires<Monoid<M>{} && std::is_same<M, PlainType<MB>>::value>>
     M operator^(MA &&ma, MB &&mb) {
-        return monoid<M>::mappend(std::forward<MA>(ma), std::forward<MB>(mb));
+        return trace::traced("mappend", ma, [&] {
+            return monoid<M>::mappend(std::forward<MA>(ma), std::forward<MB>(mb));
+        });
+    }
+
+    namespace _inner_impl {
+        template <typename M>
+        M stimes_by_squaring(std::size_t n, const M &m) {
+            if (n == 0) {
+                return monoid<M>::mempty();
+            }
+            M x = m;
+            for (; n % 2 == 0; n /= 2) {
+                x = monoid<M>::mappend(x, x);
+            }
+            M acc = x;
+            while ((n /= 2) != 0) {
+                x = monoid<M>::mappend(x, x);
+                if (n % 2 == 1) {
+                    acc = monoid<M>::mappend(std::move(acc), x);
+                }
+            }
+            return acc;
+        }
+
+        template <typename M, typename = void>
+        struct has_stimes : std::false_type {};
+
+        template <typename M>
+        struct has_stimes<M, decltype(monoid<M>::stimes(std::size_t(0), std::declval<const M &>()),
+                                      void())> : std::true_type {};
+
+        template <typename M>
+        M stimes(std::size_t n, const M &m, std::true_type) {
+            return monoid<M>::stimes(n, m);
+        }
+
+        template <typename M>
+        M stimes(std::size_t n, const M &m, std::false_type) {
+            return stimes_by_squaring(n, m);
+        }
+
+        // x^n, by repeated squaring for integers.
+        template <typename N>
+        constexpr N power(N x, std::size_t n, std::false_type) {
+            N acc = N(1);
+            for (; n != 0; n /= 2) {
+                if (n % 2 == 1) {
+                    acc = acc * x;
+                }
+                if (n > 1) {
+                    x = x * x;
+                }
+            }
+            return acc;
+        }
+
+        template <typename N>
+        N power(N x, std::size_t n, std::true_type) {
+            return static_cast<N>(std::pow(x, static_cast<N>(n)));
+        }
+    };
+
+    /**
+     * Repetition: `m <> m <> ... <> m`, `n` times, `mempty` when `n` is 0.
+     * In Haskell:
+     *      stimes :: Integral b => b -> a -> a
+     *      mtimesDefault :: Monoid a => Integral b => b -> a -> a
+     *
+     * By repeated squaring, it takes O(log n) `mappend`s. Instances can give a
+     * closed form by a static `stimes(n, m)`, e.g., the multiplication for
+     * `sum_monoid`, the power for `prod_monoid`, or filling one buffer of the
+     * exact size for containers.
+     */
+    template <typename M, typename = Requires<Monoid<M>::value>>
+    M stimes(std::size_t n, const M &m) {
+        return _inner_impl::stimes(n, m, _inner_impl::has_stimes<M>{});
+    }
+
+    // The same, named after `mtimesDefault`.
+    template <typename M, typename = Requires<Monoid<M>::value>>
+    M mtimes(std::size_t n, const M &m) {
+        return stimes(n, m);
     }
 
     /**
@@ -88,6 +176,11 @@ namespace algebra {
         static constexpr sum_monoid<N> mappend(const sum_monoid<N> &a, const sum_monoid<N> &b) {
             return a + b;
         }
+
+        // n * m.
+        static constexpr sum_monoid<N> stimes(std::size_t n, const sum_monoid<N> &m) {
+            return sum(N(m.value * N(n)));
+        }
     };
 
     /**
@@ -134,6 +227,62 @@ namespace algebra {
         static constexpr prod_monoid<N> mappend(const prod_monoid<N> &a, const prod_monoid<N> &b) {
             return a * b;
         }
+
+        // m^n.
+        static prod_monoid<N> stimes(std::size_t n, const prod_monoid<N> &m) {
+            return prod(_inner_impl::power(m.value, n, std::is_floating_point<N>{}));
+        }
+    };
+
+    /**
+     * Monoid for ordered numbers, use the maximum as `mappend`.
+     */
+    template <typename N>
+    struct max_monoid {
+        static constexpr bool instance = true;
+
+        N value;
+
+        // The least value, the negative infinity for floating point numbers.
+        static constexpr N lowest() noexcept {
+            return std::numeric_limits<N>::has_infinity ? -std::numeric_limits<N>::infinity()
+                                                        : std::numeric_limits<N>::lowest();
+        }
+
+        // Constructors.
+        constexpr max_monoid() noexcept : value(lowest()) {}
+        constexpr max_monoid(N n) noexcept(std::is_nothrow_copy_constructible<N>::value)
+                : value(n) {}
+
+        // Implicit cast to unboxed value of type `N`.
+        constexpr operator N() const noexcept { return value; }
+    };
+
+    template <typename N>
+    constexpr max_monoid<N> max(N n) noexcept(
+            std::is_nothrow_constructible<max_monoid<N>, N>::value) {
+        return max_monoid<N>(n);
+    }
+
+    /**
+     * Instance max_monoid as a monoid type.
+     */
+    template <typename N>
+    struct monoid<max_monoid<N>> {
+        static constexpr bool instance = true;
+
+        static constexpr max_monoid<N> mempty() noexcept(
+                std::is_nothrow_constructible<max_monoid<N>, N>::value) {
+            return max(max_monoid<N>::lowest());
+        }
+        static constexpr max_monoid<N> mappend(const max_monoid<N> &a, const max_monoid<N> &b) {
+            return a.value < b.value ? b : a;
+        }
+
+        // The maximum is idempotent.
+        static constexpr max_monoid<N> stimes(std::size_t n, const max_monoid<N> &m) {
+            return n == 0 ? mempty() : m;
+        }
     };
 };
 
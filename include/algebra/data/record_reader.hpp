@@ -0,0 +1,189 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_DATA_RECORD_READER_HPP__
+#define __ALGEBRA_DATA_RECORD_READER_HPP__
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <string>
+#include <system_error>
+#include "../control/stream.hpp"
+#include "../data/array_view.hpp"
+
+/**
+ * Streaming reader of delimited records (e.g. lines) of a file (POSIX only).
+ *
+ * The file is read in large page-aligned chunks into two buffers: while the
+ * records of one buffer are consumed, the next chunk is read into the other
+ * one on a background thread. Records are views into the buffers, so nothing
+ * is copied but the incomplete record at the end of a chunk. The memory used
+ * is bounded by the chunk size, whatever the size of the file.
+ *
+ * A record view is valid until the next record is pulled. A record longer than
+ * the chunk size may be split into several records.
+ *
+ * e.g.:
+ *      auto count = foldMap([](array_view<const char>) { return sum(1); }, lines("big.log"));
+ */
+namespace algebra {
+
+    using record = array_view<const char>;
+
+    class record_reader {
+        struct free_deleter {
+            void operator()(char *p) const noexcept { std::free(p); }
+        };
+        using buffer = std::unique_ptr<char, free_deleter>;
+
+        static constexpr std::size_t alignment = 4096;
+
+        int fd_;
+        char delim_;
+        std::size_t chunk_;
+        // Each buffer holds the tail of the previous chunk in its first half,
+        // and a chunk in its second half.
+        buffer buffers_[2];
+        int current_;
+        std::future<std::size_t> pending_;
+        const char *pos_, *end_;
+        bool eof_;
+
+        [[noreturn]] static void fail(const std::string &what) {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        static buffer allocate(std::size_t size) {
+            void *p = nullptr;
+            if (::posix_memalign(&p, alignment, size) != 0) {
+                throw std::bad_alloc();
+            }
+            return buffer(static_cast<char *>(p));
+        }
+
+        // Fill the second half of a buffer, return the number of bytes read,
+        // fewer than a chunk only at the end of the file.
+        static std::size_t fill(int fd, char *out, std::size_t size) {
+            std::size_t n = 0;
+            while (n < size) {
+                ssize_t r = ::read(fd, out + n, size - n);
+                if (r < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    fail("read");
+                }
+                if (r == 0) {
+                    break;
+                }
+                n += static_cast<std::size_t>(r);
+            }
+            return n;
+        }
+
+        void read_ahead(int b) {
+            pending_ = std::async(std::launch::async, &record_reader::fill, fd_,
+                                  buffers_[b].get() + chunk_, chunk_);
+        }
+
+       public:
+        // Read the records of `path` ended by `delim`, `chunk` bytes at a time.
+        explicit record_reader(const std::string &path, char delim = '\n',
+                               std::size_t chunk = std::size_t(1) << 20)
+                : delim_(delim),
+                  chunk_((chunk + alignment - 1) / alignment * alignment),
+                  current_(1),
+                  eof_(false) {
+            if (chunk_ == 0) {
+                chunk_ = alignment;
+            }
+            buffers_[0] = allocate(2 * chunk_);
+            buffers_[1] = allocate(2 * chunk_);
+            fd_ = ::open(path.c_str(), O_RDONLY);
+            if (fd_ < 0) {
+                fail("open " + path);
+            }
+#ifdef POSIX_FADV_SEQUENTIAL
+            ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+            pos_ = end_ = buffers_[current_].get() + chunk_;
+            // The destructor doesn't run if the constructor throws.
+            try {
+                read_ahead(0);
+            } catch (...) {
+                ::close(fd_);
+                throw;
+            }
+        }
+
+        record_reader(const record_reader &) = delete;
+        record_reader &operator=(const record_reader &) = delete;
+
+        ~record_reader() {
+            if (pending_.valid()) {
+                pending_.wait();
+            }
+            ::close(fd_);
+        }
+
+        // Pull the next record, return false at the end of the file. The last
+        // record needn't be ended by the delimiter.
+        bool next(record &out) {
+            for (;;) {
+                auto d = static_cast<const char *>(std::memchr(pos_, delim_, end_ - pos_));
+                if (d) {
+                    out = record(pos_, d - pos_);
+                    pos_ = d + 1;
+                    return true;
+                }
+                std::size_t tail = end_ - pos_;
+                if (eof_ || tail > chunk_) {
+                    // The last record, or a record too long to be carried over.
+                    if (tail == 0) {
+                        return false;
+                    }
+                    out = record(pos_, tail);
+                    pos_ = end_;
+                    return true;
+                }
+
+                // Carry the incomplete record over to the front of the next chunk,
+                // then reuse this buffer for reading ahead.
+                std::size_t n = pending_.get();
+                int next = 1 - current_;
+                char *chunk = buffers_[next].get() + chunk_;
+                std::memcpy(chunk - tail, pos_, tail);
+                pos_ = chunk - tail;
+                end_ = chunk + n;
+                current_ = next;
+                if (n < chunk_) {
+                    eof_ = true;
+                } else {
+                    read_ahead(1 - current_);
+                }
+            }
+        }
+    };
+
+    // The stream of the records of a file, ended by `delim`.
+    inline stream<record> read_records(const std::string &path, char delim = '\n',
+                                       std::size_t chunk = std::size_t(1) << 20) {
+        auto reader = std::make_shared<record_reader>(path, delim, chunk);
+        return stream<record>([reader](record &out) { return reader->next(out); });
+    }
+
+    // The stream of the lines of a file, without the line breaks.
+    inline stream<record> lines(const std::string &path,
+                                std::size_t chunk = std::size_t(1) << 20) {
+        return read_records(path, '\n', chunk);
+    }
+};
+
+#endif /* __ALGEBRA_DATA_RECORD_READER_HPP__ */
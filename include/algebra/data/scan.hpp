@@ -0,0 +1,543 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_DATA_SCAN_HPP__
+#define __ALGEBRA_DATA_SCAN_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../basic/type_concepts.hpp"
+#include "../basic/type_operation.hpp"
+#include "../basic/worker_group.hpp"
+#include "../data/monoid.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * Scans: the prefixes of `foldMap`, every partial `mappend` of a range,
+ * e.g., running totals with `sum_monoid` or running maxima with `max_monoid`.
+ *
+ *  + `scanl1 fn xs = [x0, x0 <> x1, ..., x0 <> ... <> xn-1]`, the inclusive scan,
+ *  + `scanl fn xs = [mempty, x0, ..., x0 <> ... <> xn-1]`, the exclusive scan
+ *    followed by the total,
+ *  + `scanr1` and `scanr`, the same for the suffixes,
+ *  + `segmented_scanl1 fn xs flags`, the inclusive scan restarted wherever a
+ *    flag is set, for many small scans in a single pass.
+ *
+ * where `xi` stands for `fn(xi)`. e.g.:
+ *      auto balance = scanl1(sum<double>, deposits);
+ *      auto record = parallel_scanl1(max<float>, readings);
+ *
+ * The `parallel_` scans split large ranges over threads in two passes: every
+ * chunk is reduced, the totals of the chunks are scanned, then every chunk is
+ * scanned from the total of the chunks before it, which is sound as `mappend`
+ * is associative. Where SSE2 is available, the scans of `max_monoid` of
+ * floating point numbers and of `sum_monoid` of `float` and of integers of 32
+ * and 64 bits run on SIMD registers: sums of `float` may then be rounded
+ * differently than a sequential loop would.
+ */
+namespace algebra {
+
+    namespace _inner_impl {
+        // The values of a scan from right to left: `mappend` with the operands
+        // swapped, like `Dual` in Haskell.
+        template <typename M>
+        struct flipped {
+            M value;
+        };
+
+        // The values of a segmented scan: whether a segment starts at the
+        // value, and the value.
+        template <typename M>
+        struct segmented {
+            bool start;
+            M value;
+        };
+    };
+
+    template <typename M>
+    struct monoid<_inner_impl::flipped<M>> {
+        static constexpr bool instance = true;
+
+        static _inner_impl::flipped<M> mempty() { return {monoid<M>::mempty()}; }
+
+        static _inner_impl::flipped<M> mappend(const _inner_impl::flipped<M> &a,
+                                               const _inner_impl::flipped<M> &b) {
+            return {monoid<M>::mappend(b.value, a.value)};
+        }
+    };
+
+    // A segment that starts on the right discards the values on its left:
+    //      (f1, v1) <> (f2, v2) = (f1 || f2, if f2 then v2 else v1 <> v2)
+    template <typename M>
+    struct monoid<_inner_impl::segmented<M>> {
+        static constexpr bool instance = true;
+
+        static _inner_impl::segmented<M> mempty() { return {false, monoid<M>::mempty()}; }
+
+        static _inner_impl::segmented<M> mappend(const _inner_impl::segmented<M> &a,
+                                                 const _inner_impl::segmented<M> &b) {
+            return {a.start || b.start, b.start ? b.value : monoid<M>::mappend(a.value, b.value)};
+        }
+    };
+
+    namespace _inner_impl {
+        // The number of values scanned at a time by one thread, so that they
+        // are scanned while they're still in the L1 cache.
+        constexpr std::size_t scan_block = 2048;
+
+#if defined(__SSE2__)
+        // The inclusive scan of the lanes of SIMD registers in log2(width)
+        // steps: `mappend` with the register shifted by one lane, then by two,
+        // the identity shifted in. The last lane is then the carry of the next
+        // register.
+        template <bool Max>
+        struct sse_ps {
+            using T = float;
+            using V = __m128;
+            static constexpr std::size_t width = 4;
+
+            static T identity() { return Max ? max_monoid<T>::lowest() : T(0); }
+            static T op(T a, T b) { return Max ? (a < b ? b : a) : a + b; }
+            static V op(V a, V b) { return Max ? _mm_max_ps(a, b) : _mm_add_ps(a, b); }
+            static V set1(T x) { return _mm_set1_ps(x); }
+            static V load(const T *p) { return _mm_loadu_ps(p); }
+            static void store(T *p, V x) { _mm_storeu_ps(p, x); }
+            static V scan(V x, V id) {
+                x = op(x, _mm_move_ss(_mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 1, 0, 0)), id));
+                return op(x, _mm_movelh_ps(id, x));
+            }
+            static V last(V x) { return _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3)); }
+            static T first(V x) { return _mm_cvtss_f32(x); }
+        };
+
+        // Only the maxima: the sums of 2 lanes are no faster than a loop.
+        template <bool Max>
+        struct sse_pd {
+            using T = double;
+            using V = __m128d;
+            static constexpr std::size_t width = 2;
+
+            static T identity() { return Max ? max_monoid<T>::lowest() : T(0); }
+            static T op(T a, T b) { return Max ? (a < b ? b : a) : a + b; }
+            static V op(V a, V b) { return Max ? _mm_max_pd(a, b) : _mm_add_pd(a, b); }
+            static V set1(T x) { return _mm_set1_pd(x); }
+            static V load(const T *p) { return _mm_loadu_pd(p); }
+            static void store(T *p, V x) { _mm_storeu_pd(p, x); }
+            static V scan(V x, V id) { return op(x, _mm_shuffle_pd(id, x, 0)); }
+            static V last(V x) { return _mm_unpackhi_pd(x, x); }
+            static T first(V x) { return _mm_cvtsd_f64(x); }
+        };
+
+        // Sums of integers, whose identity 0 is shifted in by the byte shifts.
+        template <typename I>
+        struct sse_epi32_sum {
+            using T = I;
+            using V = __m128i;
+            static constexpr std::size_t width = 4;
+
+            static T identity() { return T(0); }
+            static T op(T a, T b) { return T(a + b); }
+            static V op(V a, V b) { return _mm_add_epi32(a, b); }
+            static V set1(T x) { return _mm_set1_epi32(static_cast<int>(x)); }
+            static V load(const T *p) { return _mm_loadu_si128(reinterpret_cast<const V *>(p)); }
+            static void store(T *p, V x) { _mm_storeu_si128(reinterpret_cast<V *>(p), x); }
+            static V scan(V x, V) {
+                x = op(x, _mm_slli_si128(x, 4));
+                return op(x, _mm_slli_si128(x, 8));
+            }
+            static V last(V x) { return _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3)); }
+            static T first(V x) { return static_cast<T>(_mm_cvtsi128_si32(x)); }
+        };
+
+        template <typename I>
+        struct sse_epi64_sum {
+            using T = I;
+            using V = __m128i;
+            static constexpr std::size_t width = 2;
+
+            static T identity() { return T(0); }
+            static T op(T a, T b) { return T(a + b); }
+            static V op(V a, V b) { return _mm_add_epi64(a, b); }
+            static V set1(T x) { return _mm_set1_epi64x(static_cast<long long>(x)); }
+            static V load(const T *p) { return _mm_loadu_si128(reinterpret_cast<const V *>(p)); }
+            static void store(T *p, V x) { _mm_storeu_si128(reinterpret_cast<V *>(p), x); }
+            static V scan(V x, V) { return op(x, _mm_slli_si128(x, 8)); }
+            static V last(V x) { return _mm_unpackhi_epi64(x, x); }
+            static T first(V x) {
+                T t;
+                _mm_storel_epi64(reinterpret_cast<V *>(&t), x);
+                return t;
+            }
+        };
+
+        // p[0, n) = the inclusive scan of p[0, n) after `carry`, gives the last prefix.
+        template <typename L, typename T = typename L::T>
+        T scan_lanes(T *p, std::size_t n, T carry) {
+            using V = typename L::V;
+            constexpr std::size_t width = L::width;
+            std::size_t i = 0;
+            if (n >= width) {
+                V c = L::set1(carry), id = L::set1(L::identity());
+                for (; i + width <= n; i += width) {
+                    V x = L::op(L::scan(L::load(p + i), id), c);
+                    L::store(p + i, x);
+                    c = L::last(x);
+                }
+                carry = L::first(c);
+            }
+            for (; i < n; ++i) {
+                carry = L::op(carry, p[i]);
+                p[i] = carry;
+            }
+            return carry;
+        }
+#endif
+
+        // The SIMD kernel of a monoid, if any.
+        template <typename M>
+        struct scan_kernel {
+            using type = void;
+        };
+
+#if defined(__SSE2__)
+        template <>
+        struct scan_kernel<sum_monoid<float>> {
+            using type = sse_ps<false>;
+        };
+
+        template <>
+        struct scan_kernel<max_monoid<float>> {
+            using type = sse_ps<true>;
+        };
+
+        template <>
+        struct scan_kernel<max_monoid<double>> {
+            using type = sse_pd<true>;
+        };
+
+        template <>
+        struct scan_kernel<sum_monoid<std::int32_t>> {
+            using type = sse_epi32_sum<std::int32_t>;
+        };
+
+        template <>
+        struct scan_kernel<sum_monoid<std::uint32_t>> {
+            using type = sse_epi32_sum<std::uint32_t>;
+        };
+
+        template <>
+        struct scan_kernel<sum_monoid<std::int64_t>> {
+            using type = sse_epi64_sum<std::int64_t>;
+        };
+
+        template <>
+        struct scan_kernel<sum_monoid<std::uint64_t>> {
+            using type = sse_epi64_sum<std::uint64_t>;
+        };
+
+        // The monoids of the kernels wrap a single number.
+        template <typename M>
+        M scan_inclusive(M *p, std::size_t n, M carry, std::false_type) {
+            using L = typename scan_kernel<M>::type;
+            using T = typename L::T;
+            static_assert(sizeof(M) == sizeof(T) && std::is_standard_layout<M>::value,
+                          "the monoid must have the layout of its number");
+            return M(scan_lanes<L>(reinterpret_cast<T *>(p), n, carry.value));
+        }
+#endif
+
+        template <typename M>
+        M scan_inclusive(M *p, std::size_t n, M carry, std::true_type) {
+            for (std::size_t i = 0; i < n; ++i) {
+                carry = monoid<M>::mappend(std::move(carry), std::move(p[i]));
+                p[i] = carry;
+            }
+            return carry;
+        }
+
+        // p[0, n) = the inclusive scan of p[0, n) after `carry`, gives the last prefix.
+        template <typename M>
+        M scan_inclusive(M *p, std::size_t n, M carry) {
+            return scan_inclusive(p, n, std::move(carry),
+                                  std::is_void<typename scan_kernel<M>::type>{});
+        }
+
+        // The number of threads of a parallel scan of `n` values, all the
+        // cores if 0, but at least `grain` values a thread.
+        inline std::size_t scan_threads(std::size_t n, std::size_t threads, std::size_t grain) {
+            if (threads == 0) {
+                threads = std::thread::hardware_concurrency();
+            }
+            if (grain == 0) {
+                grain = 1;
+            }
+            return std::min(threads, n / grain);
+        }
+
+        // Runs `body(i, first, last)` on the `chunks` contiguous ranges of
+        // [0, n), each on its own thread, the caller takes the last. The
+        // exception of any chunk is thrown once all the threads are joined.
+        template <typename Body>
+        void for_chunks(std::size_t n, std::size_t chunks, Body &body) {
+            worker_group workers(chunks - 1);
+            for (std::size_t i = 0; i < chunks; ++i) {
+                std::size_t first = n * i / chunks, last = n * (i + 1) / chunks;
+                if (i + 1 == chunks) {
+                    body(i, first, last);
+                } else {
+                    workers.spawn([&body, i, first, last] { body(i, first, last); });
+                }
+            }
+            workers.join();
+        }
+
+        // The values are scanned as they're generated.
+        template <typename M, typename Next>
+        void scan_sequential(std::vector<M> &out, std::size_t n, Next &next, std::true_type) {
+            M carry = monoid<M>::mempty();
+            for (std::size_t k = 0; k < n; ++k) {
+                carry = monoid<M>::mappend(std::move(carry), next());
+                out.push_back(carry);
+            }
+        }
+
+        // A block at a time for the SIMD kernels: the values are scanned while
+        // they're still in the cache.
+        template <typename M, typename Next>
+        void scan_sequential(std::vector<M> &out, std::size_t n, Next &next, std::false_type) {
+            M carry = monoid<M>::mempty();
+            for (std::size_t b = 0; b < n; b += scan_block) {
+                std::size_t e = std::min(n, b + scan_block);
+                for (std::size_t k = b; k < e; ++k) {
+                    out.push_back(next());
+                }
+                carry = scan_inclusive(out.data() + b, e - b, std::move(carry));
+            }
+        }
+
+        // The inclusive scan of `n` values, where `make_next(k)` gives a
+        // generator of the values from the `k`-th on.
+        template <typename M, typename MakeNext>
+        std::vector<M> scan(std::size_t n, MakeNext &make_next, std::size_t threads) {
+            std::vector<M> out;
+            if (threads <= 1) {
+                out.reserve(n + 1);
+                auto next = make_next(0);
+                scan_sequential(out, n, next, std::is_void<typename scan_kernel<M>::type>{});
+                return out;
+            }
+
+            // Every chunk is reduced, the totals are scanned into the carries
+            // of the chunks, then every chunk is scanned from its carry.
+            out.resize(n, monoid<M>::mempty());
+            M *p = out.data();
+            std::vector<M> carries(threads, monoid<M>::mempty());
+            auto reduce = [&](std::size_t i, std::size_t b, std::size_t e) {
+                auto next = make_next(b);
+                M acc = monoid<M>::mempty();
+                for (std::size_t k = b; k < e; ++k) {
+                    p[k] = next();
+                    acc = monoid<M>::mappend(std::move(acc), p[k]);
+                }
+                carries[i] = std::move(acc);
+            };
+            for_chunks(n, threads, reduce);
+            M carry = monoid<M>::mempty();
+            for (auto &c : carries) {
+                M total = monoid<M>::mappend(carry, c);
+                c = std::move(carry);
+                carry = std::move(total);
+            }
+            auto local = [&](std::size_t i, std::size_t b, std::size_t e) {
+                scan_inclusive(p + b, e - b, std::move(carries[i]));
+            };
+            for_chunks(n, threads, local);
+            return out;
+        }
+
+        template <typename M, typename Fn, typename F>
+        std::vector<M> scanl1(Fn &fn, const F &f, std::size_t threads) {
+            auto first = std::begin(f);
+            std::size_t n = static_cast<std::size_t>(std::distance(first, std::end(f)));
+            auto make_next = [&fn, first](std::size_t k) {
+                return [&fn, it = std::next(first, k)]() mutable -> M { return fn(*it++); };
+            };
+            return scan<M>(n, make_next, threads);
+        }
+
+        // Scans the reversed range with the operands of `mappend` swapped.
+        template <typename M, typename Fn, typename F>
+        std::vector<M> scanr1(Fn &fn, const F &f, std::size_t threads) {
+            auto first = std::rbegin(f);
+            std::size_t n = static_cast<std::size_t>(std::distance(first, std::rend(f)));
+            auto make_next = [&fn, first](std::size_t k) {
+                return [&fn, it = std::next(first, k)]() mutable {
+                    return flipped<M>{fn(*it++)};
+                };
+            };
+            auto out = scan<flipped<M>>(n, make_next, threads);
+            std::vector<M> result;
+            result.reserve(n + 1);
+            for (auto it = out.rbegin(); it != out.rend(); ++it) {
+                result.push_back(std::move(it->value));
+            }
+            return result;
+        }
+
+        template <typename M, typename Fn, typename F, typename G>
+        std::vector<M> segmented_scanl1(Fn &fn, const F &f, const G &flags, std::size_t threads) {
+            auto first = std::begin(f);
+            auto flag = std::begin(flags);
+            std::size_t n = static_cast<std::size_t>(std::distance(first, std::end(f)));
+            if (static_cast<std::size_t>(std::distance(flag, std::end(flags))) != n) {
+                throw std::invalid_argument("segmented_scanl1: as many flags as values expected");
+            }
+            auto make_next = [&fn, first, flag](std::size_t k) {
+                return [&fn, it = std::next(first, k), fl = std::next(flag, k)]() mutable {
+                    bool start = static_cast<bool>(*fl++);
+                    return segmented<M>{start, fn(*it++)};
+                };
+            };
+            auto out = scan<segmented<M>>(n, make_next, threads);
+            std::vector<M> result;
+            result.reserve(n);
+            for (auto &s : out) {
+                result.push_back(std::move(s.value));
+            }
+            return result;
+        }
+    };
+
+    /**
+     * Scans from the left.
+     */
+
+    // The inclusive scan, n prefixes.
+    template <typename Fn, typename F,
+              typename T = typename std::iterator_traits<decltype(std::begin(
+                      std::declval<const F &>()))>::value_type,
+              typename M = ResultOf<Fn(T)>, typename = Requires<Monoid<M>::value>>
+    std::vector<M> scanl1(Fn &&fn, const F &f) {
+        return _inner_impl::scanl1<M>(fn, f, 1);
+    }
+
+    // The exclusive scan followed by the total, n + 1 prefixes from `mempty`.
+    template <typename Fn, typename F,
+              typename T = typename std::iterator_traits<decltype(std::begin(
+                      std::declval<const F &>()))>::value_type,
+              typename M = ResultOf<Fn(T)>, typename = Requires<Monoid<M>::value>>
+    std::vector<M> scanl(Fn &&fn, const F &f) {
+        auto out = _inner_impl::scanl1<M>(fn, f, 1);
+        out.insert(out.begin(), monoid<M>::mempty());
+        return out;
+    }
+
+    /**
+     * Scans from the right.
+     */
+
+    // The inclusive scan, n suffixes.
+    template <typename Fn, typename F,
+              typename T = typename std::iterator_traits<decltype(std::begin(
+                      std::declval<const F &>()))>::value_type,
+              typename M = ResultOf<Fn(T)>, typename = Requires<Monoid<M>::value>>
+    std::vector<M> scanr1(Fn &&fn, const F &f) {
+        return _inner_impl::scanr1<M>(fn, f, 1);
+    }
+
+    // The total followed by the exclusive scan, n + 1 suffixes to `mempty`.
+    template <typename Fn, typename F,
+              typename T = typename std::iterator_traits<decltype(std::begin(
+                      std::declval<const F &>()))>::value_type,
+              typename M = ResultOf<Fn(T)>, typename = Requires<Monoid<M>::value>>
+    std::vector<M> scanr(Fn &&fn, const F &f) {
+        auto out = _inner_impl::scanr1<M>(fn, f, 1);
+        out.push_back(monoid<M>::mempty());
+        return out;
+    }
+
+    /**
+     * Segmented scans: the inclusive scan from the left, restarted at every
+     * value whose flag is set. Throws `std::invalid_argument` if there aren't
+     * as many flags as values.
+     */
+    template <typename Fn, typename F, typename G,
+              typename T = typename std::iterator_traits<decltype(std::begin(
+                      std::declval<const F &>()))>::value_type,
+              typename M = ResultOf<Fn(T)>, typename = Requires<Monoid<M>::value>>
+    std::vector<M> segmented_scanl1(Fn &&fn, const F &f, const G &flags) {
+        return _inner_impl::segmented_scanl1<M>(fn, f, flags, 1);
+    }
+
+    /**
+     * Parallel scans, on `threads` threads, all the cores if 0, each of at
+     * least `grain` values. Small ranges are scanned on the calling thread.
+     */
+
+    template <typename Fn, typename F,
+              typename T = typename std::iterator_traits<decltype(std::begin(
+                      std::declval<const F &>()))>::value_type,
+              typename M = ResultOf<Fn(T)>, typename = Requires<Monoid<M>::value>>
+    std::vector<M> parallel_scanl1(Fn &&fn, const F &f, std::size_t threads = 0,
+                                   std::size_t grain = 4096) {
+        std::size_t n = static_cast<std::size_t>(std::distance(std::begin(f), std::end(f)));
+        return _inner_impl::scanl1<M>(fn, f, _inner_impl::scan_threads(n, threads, grain));
+    }
+
+    template <typename Fn, typename F,
+              typename T = typename std::iterator_traits<decltype(std::begin(
+                      std::declval<const F &>()))>::value_type,
+              typename M = ResultOf<Fn(T)>, typename = Requires<Monoid<M>::value>>
+    std::vector<M> parallel_scanl(Fn &&fn, const F &f, std::size_t threads = 0,
+                                  std::size_t grain = 4096) {
+        auto out = parallel_scanl1(std::forward<Fn>(fn), f, threads, grain);
+        out.insert(out.begin(), monoid<M>::mempty());
+        return out;
+    }
+
+    template <typename Fn, typename F,
+              typename T = typename std::iterator_traits<decltype(std::begin(
+                      std::declval<const F &>()))>::value_type,
+              typename M = ResultOf<Fn(T)>, typename = Requires<Monoid<M>::value>>
+    std::vector<M> parallel_scanr1(Fn &&fn, const F &f, std::size_t threads = 0,
+                                   std::size_t grain = 4096) {
+        std::size_t n = static_cast<std::size_t>(std::distance(std::begin(f), std::end(f)));
+        return _inner_impl::scanr1<M>(fn, f, _inner_impl::scan_threads(n, threads, grain));
+    }
+
+    template <typename Fn, typename F,
+              typename T = typename std::iterator_traits<decltype(std::begin(
+                      std::declval<const F &>()))>::value_type,
+              typename M = ResultOf<Fn(T)>, typename = Requires<Monoid<M>::value>>
+    std::vector<M> parallel_scanr(Fn &&fn, const F &f, std::size_t threads = 0,
+                                  std::size_t grain = 4096) {
+        auto out = parallel_scanr1(std::forward<Fn>(fn), f, threads, grain);
+        out.push_back(monoid<M>::mempty());
+        return out;
+    }
+
+    template <typename Fn, typename F, typename G,
+              typename T = typename std::iterator_traits<decltype(std::begin(
+                      std::declval<const F &>()))>::value_type,
+              typename M = ResultOf<Fn(T)>, typename = Requires<Monoid<M>::value>>
+    std::vector<M> parallel_segmented_scanl1(Fn &&fn, const F &f, const G &flags,
+                                             std::size_t threads = 0, std::size_t grain = 4096) {
+        std::size_t n = static_cast<std::size_t>(std::distance(std::begin(f), std::end(f)));
+        return _inner_impl::segmented_scanl1<M>(fn, f, flags,
+                                                _inner_impl::scan_threads(n, threads, grain));
+    }
+};
+
+#endif /* __ALGEBRA_DATA_SCAN_HPP__ */
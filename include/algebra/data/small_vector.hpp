@@ -0,0 +1,659 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_DATA_SMALL_VECTOR_HPP__
+#define __ALGEBRA_DATA_SMALL_VECTOR_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include "../basic/instrument.hpp"
+#include "../basic/type_concepts.hpp"
+#include "../basic/type_operation.hpp"
+#include "../basic/type_reflection.hpp"
+#include "../control/functor.hpp"
+#include "../control/monad.hpp"
+#include "../data/foldable.hpp"
+#include "../data/monoid.hpp"
+
+/**
+ * A vector with inline capacity for `N` elements. Elements live inside the
+ * object itself until the size exceeds `N`, only then the storage moves to
+ * the heap through the allocator `A`.
+ *
+ * Short results of `bind` callbacks (the typical list monad usage) are then
+ * built without touching the heap at all.
+ *
+ * Trivially relocatable elements (see `type_reflection.hpp`) are moved to new
+ * storage with `memcpy`, when growing and when splicing a vector into another
+ * one, as `mappend` and `bind` do. An rvalue `fmap` to a type of the same
+ * size and alignment (both trivially copyable, e.g., `std::int32_t` to
+ * `float`) converts the elements in place and hands the heap buffer over to
+ * the result.
+ */
+namespace algebra {
+
+    template <typename T, std::size_t N, typename A = std::allocator<T>>
+    class small_vector : private A {
+       public:
+        using value_type = T;
+        using allocator_type = A;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using iterator = T *;
+        using const_iterator = const T *;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+       private:
+        template <typename, std::size_t, typename>
+        friend class small_vector;
+
+        using alloc_traits = std::allocator_traits<A>;
+
+        // Moves of inline elements don't throw.
+        using nothrow_relocatable =
+                std::integral_constant<bool, std::is_nothrow_move_constructible<T>::value ||
+                                                     TriviallyRelocatable<T>::value>;
+
+        // The heap buffer of another vector can always be taken over.
+        using steals_buffer = std::integral_constant<
+                bool, alloc_traits::propagate_on_container_move_assignment::value ||
+                              alloc_traits::is_always_equal::value>;
+
+        T *begin_;
+        size_type size_;
+        size_type capacity_;
+        alignas(T) unsigned char inline_[sizeof(T) * (N == 0 ? 1 : N)];
+
+        T *inline_data() noexcept { return reinterpret_cast<T *>(inline_); }
+
+        A &alloc() noexcept { return *this; }
+
+        void destroy_all() noexcept {
+            for (size_type i = 0; i < size_; ++i) {
+                alloc_traits::destroy(alloc(), begin_ + i);
+            }
+            size_ = 0;
+        }
+
+        void release() noexcept {
+            if (!is_inline()) {
+                alloc_traits::deallocate(alloc(), begin_, capacity_);
+                begin_ = inline_data();
+                capacity_ = N;
+            }
+        }
+
+        // Move (or copy, when moving may throw) `n` elements into raw storage.
+        void relocate(T *from, size_type n, T *to, std::false_type) {
+            for (size_type i = 0; i < n; ++i) {
+                alloc_traits::construct(alloc(), to + i, std::move_if_noexcept(from[i]));
+                alloc_traits::destroy(alloc(), from + i);
+            }
+        }
+
+        void relocate(T *from, size_type n, T *to, std::true_type) noexcept {
+            if (n != 0) {
+                std::memcpy(static_cast<void *>(to), static_cast<const void *>(from),
+                            n * sizeof(T));
+            }
+        }
+
+        void relocate(T *from, size_type n, T *to) {
+            relocate(from, n, to, std::integral_constant<bool, TriviallyRelocatable<T>::value>{});
+        }
+
+        void grow_to(size_type cap) {
+            T *buffer = alloc_traits::allocate(alloc(), cap);
+            relocate(begin_, size_, buffer);
+            release();
+            begin_ = buffer;
+            capacity_ = cap;
+        }
+
+        size_type next_capacity(size_type required) const noexcept {
+            return std::max(required, capacity_ * 2);
+        }
+
+        // Construct the new element in the new buffer before relocating the old
+        // ones, since the arguments may refer to elements of this vector.
+        template <typename... Args>
+        void grow_emplace_back(Args &&... args) {
+            size_type cap = next_capacity(size_ + 1);
+            T *buffer = alloc_traits::allocate(alloc(), cap);
+            try {
+                alloc_traits::construct(alloc(), buffer + size_, std::forward<Args>(args)...);
+            } catch (...) {
+                alloc_traits::deallocate(alloc(), buffer, cap);
+                throw;
+            }
+            relocate(begin_, size_, buffer);
+            release();
+            begin_ = buffer;
+            capacity_ = cap;
+            ++size_;
+        }
+
+        // Take over the elements of `other`, stealing its heap buffer if any.
+        void steal(small_vector &other) {
+            if (other.is_inline()) {
+                reserve(other.size_);
+                relocate(other.begin_, other.size_, begin_);
+                size_ = other.size_;
+                other.size_ = 0;
+            } else {
+                begin_ = other.begin_;
+                size_ = other.size_;
+                capacity_ = other.capacity_;
+                other.begin_ = other.inline_data();
+                other.size_ = 0;
+                other.capacity_ = N;
+            }
+        }
+
+        void propagate(small_vector &other, std::true_type) noexcept {
+            alloc() = std::move(other.alloc());
+        }
+
+        void propagate(small_vector &, std::false_type) noexcept {}
+
+        void move_assign(small_vector &other, std::true_type) {
+            destroy_all();
+            release();
+            propagate(other, typename alloc_traits::propagate_on_container_move_assignment{});
+            steal(other);
+        }
+
+        // Unequal allocators that don't propagate: the elements are moved one
+        // by one into storage of this allocator.
+        void move_assign(small_vector &other, std::false_type) {
+            if (alloc() == other.alloc()) {
+                move_assign(other, std::true_type{});
+                return;
+            }
+            clear();
+            reserve(other.size_);
+            for (auto &x : other) {
+                emplace_back(std::move(x));
+            }
+            other.clear();
+        }
+
+        template <typename It>
+        void append(It first, It last, std::input_iterator_tag) {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+
+        template <typename It>
+        void append(It first, It last, std::forward_iterator_tag) {
+            reserve(size_ + static_cast<size_type>(std::distance(first, last)));
+            for (; first != last; ++first) {
+                alloc_traits::construct(alloc(), begin_ + size_, *first);
+                ++size_;
+            }
+        }
+
+       public:
+        /**
+         * Constructors.
+         */
+
+        small_vector() noexcept(std::is_nothrow_default_constructible<A>::value)
+                : A(), begin_(inline_data()), size_(0), capacity_(N) {}
+
+        explicit small_vector(const A &a) noexcept
+                : A(a), begin_(inline_data()), size_(0), capacity_(N) {}
+
+        small_vector(size_type n, const T &value, const A &a = A()) : small_vector(a) {
+            reserve(n);
+            for (size_type i = 0; i < n; ++i) {
+                emplace_back(value);
+            }
+        }
+
+        template <typename It, typename = Requires<!std::is_integral<It>::value>>
+        small_vector(It first, It last, const A &a = A()) : small_vector(a) {
+            insert(end(), first, last);
+        }
+
+        small_vector(std::initializer_list<T> l, const A &a = A()) : small_vector(a) {
+            insert(end(), l.begin(), l.end());
+        }
+
+        small_vector(const small_vector &other)
+                : small_vector(alloc_traits::select_on_container_copy_construction(other)) {
+            insert(end(), other.begin(), other.end());
+        }
+
+        small_vector(small_vector &&other) noexcept(nothrow_relocatable::value)
+                : small_vector(static_cast<const A &>(other)) {
+            steal(other);
+        }
+
+        ~small_vector() {
+            destroy_all();
+            release();
+        }
+
+        small_vector &operator=(const small_vector &other) {
+            if (this != &other) {
+                clear();
+                insert(end(), other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        small_vector &operator=(small_vector &&other) noexcept(nothrow_relocatable::value &&
+                                                               steals_buffer::value) {
+            if (this != &other) {
+                move_assign(other, steals_buffer{});
+            }
+            return *this;
+        }
+
+        small_vector &operator=(std::initializer_list<T> l) {
+            clear();
+            insert(end(), l.begin(), l.end());
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept { return *this; }
+
+        /**
+         * Iterators.
+         */
+
+        iterator begin() noexcept { return begin_; }
+        const_iterator begin() const noexcept { return begin_; }
+        const_iterator cbegin() const noexcept { return begin_; }
+        iterator end() noexcept { return begin_ + size_; }
+        const_iterator end() const noexcept { return begin_ + size_; }
+        const_iterator cend() const noexcept { return begin_ + size_; }
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+        /**
+         * Capacity.
+         */
+
+        bool empty() const noexcept { return size_ == 0; }
+        size_type size() const noexcept { return size_; }
+        size_type capacity() const noexcept { return capacity_; }
+        static constexpr size_type inline_capacity() noexcept { return N; }
+
+        // If the elements are still stored inside the object.
+        bool is_inline() const noexcept {
+            return begin_ == reinterpret_cast<const T *>(inline_);
+        }
+
+        void reserve(size_type n) {
+            if (n > capacity_) {
+                grow_to(n);
+            }
+        }
+
+        void shrink_to_fit() {
+            if (!is_inline() && size_ <= N) {
+                T *buffer = begin_;
+                size_type cap = capacity_;
+                begin_ = inline_data();
+                capacity_ = N;
+                relocate(buffer, size_, begin_);
+                alloc_traits::deallocate(alloc(), buffer, cap);
+            }
+        }
+
+        /**
+         * Element access.
+         */
+
+        reference operator[](size_type i) noexcept { return begin_[i]; }
+        const_reference operator[](size_type i) const noexcept { return begin_[i]; }
+        reference front() noexcept { return begin_[0]; }
+        const_reference front() const noexcept { return begin_[0]; }
+        reference back() noexcept { return begin_[size_ - 1]; }
+        const_reference back() const noexcept { return begin_[size_ - 1]; }
+        T *data() noexcept { return begin_; }
+        const T *data() const noexcept { return begin_; }
+
+        /**
+         * Modifiers.
+         */
+
+        template <typename... Args>
+        reference emplace_back(Args &&... args) {
+            if (size_ == capacity_) {
+                grow_emplace_back(std::forward<Args>(args)...);
+            } else {
+                alloc_traits::construct(alloc(), begin_ + size_, std::forward<Args>(args)...);
+                ++size_;
+            }
+            return back();
+        }
+
+        void push_back(const T &value) { emplace_back(value); }
+        void push_back(T &&value) { emplace_back(std::move(value)); }
+
+        void pop_back() noexcept {
+            --size_;
+            alloc_traits::destroy(alloc(), begin_ + size_);
+        }
+
+        void clear() noexcept { destroy_all(); }
+
+        // Map the elements into a vector of `U`, in the storage of this vector
+        // when it's on the heap. This vector is left empty.
+        template <typename U, typename Fn,
+                  typename R = small_vector<U, N, typename alloc_traits::template rebind_alloc<U>>>
+        R transmute(Fn &&fn) && {
+            static_assert(StorageCompatible<T, U>::value,
+                          "small_vector::transmute: incompatible element types");
+            R result{typename R::allocator_type(alloc())};
+            if (is_inline()) {
+                for (size_type i = 0; i < size_; ++i) {
+                    result.emplace_back(fn(std::move(begin_[i])));
+                }
+                clear();
+                return result;
+            }
+            try {
+                for (size_type i = 0; i < size_; ++i) {
+                    T x = begin_[i];
+                    ::new (static_cast<void *>(begin_ + i)) U(fn(std::move(x)));
+                }
+            } catch (...) {
+                // The elements are trivially destructible, whatever their type.
+                size_ = 0;
+                throw;
+            }
+            result.begin_ = static_cast<U *>(static_cast<void *>(begin_));
+            result.size_ = size_;
+            result.capacity_ = capacity_;
+            begin_ = inline_data();
+            size_ = 0;
+            capacity_ = N;
+            return result;
+        }
+
+        // Move the elements of `other` to the end, leaving `other` empty. The
+        // heap buffer of `other` is taken over when this vector is empty.
+        void splice_back(small_vector &&other) {
+            if (this == &other) {
+                return;
+            }
+            if (empty() && !other.is_inline() && alloc() == other.alloc()) {
+                release();
+                steal(other);
+                return;
+            }
+            reserve(size_ + other.size_);
+            relocate(other.begin_, other.size_, begin_ + size_);
+            size_ += other.size_;
+            other.size_ = 0;
+        }
+
+        void resize(size_type n) {
+            while (size_ > n) {
+                pop_back();
+            }
+            reserve(n);
+            while (size_ < n) {
+                emplace_back();
+            }
+        }
+
+        iterator insert(const_iterator pos, const T &value) {
+            size_type offset = static_cast<size_type>(pos - begin_);
+            emplace_back(value);
+            std::rotate(begin_ + offset, end() - 1, end());
+            return begin_ + offset;
+        }
+
+        iterator insert(const_iterator pos, T &&value) {
+            size_type offset = static_cast<size_type>(pos - begin_);
+            emplace_back(std::move(value));
+            std::rotate(begin_ + offset, end() - 1, end());
+            return begin_ + offset;
+        }
+
+        template <typename It, typename = Requires<!std::is_integral<It>::value>>
+        iterator insert(const_iterator pos, It first, It last) {
+            size_type offset = static_cast<size_type>(pos - begin_), old = size_;
+            append(first, last, typename std::iterator_traits<It>::iterator_category{});
+            std::rotate(begin_ + offset, begin_ + old, end());
+            return begin_ + offset;
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            iterator f = begin_ + (first - begin_), l = begin_ + (last - begin_);
+            iterator e = std::move(l, end(), f);
+            while (end() != e) {
+                pop_back();
+            }
+            return f;
+        }
+
+        iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+        void swap(small_vector &other) {
+            small_vector t(std::move(other));
+            other = std::move(*this);
+            *this = std::move(t);
+        }
+
+        /**
+         * Comparison.
+         */
+
+        friend bool operator==(const small_vector &a, const small_vector &b) {
+            return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+        }
+
+        friend bool operator!=(const small_vector &a, const small_vector &b) { return !(a == b); }
+
+        friend bool operator<(const small_vector &a, const small_vector &b) {
+            return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+        }
+    };
+
+    template <typename T, std::size_t N, typename A>
+    void swap(small_vector<T, N, A> &a, small_vector<T, N, A> &b) {
+        a.swap(b);
+    }
+
+    // Specialize `Rebind` for `small_vector`, the inline capacity is kept.
+    template <typename T, std::size_t N, typename A>
+    struct parametric_type_traits<small_vector<T, N, A>> {
+       private:
+        template <typename U>
+        using rebind_allocator = typename std::allocator_traits<A>::template rebind_alloc<U>;
+
+       public:
+        using value_type = T;
+
+        template <typename U>
+        using rebind = small_vector<U, N, rebind_allocator<U>>;
+    };
+
+    /**
+     * small_vector as monoid.
+     */
+    template <typename T, std::size_t N, typename A>
+    struct monoid<small_vector<T, N, A>> {
+        using M = small_vector<T, N, A>;
+
+        static M mempty() { return M{}; }
+
+        static M mappend(const M &l1, const M &l2) {
+            ALGEBRA_INSTRUMENT_SCOPE(mappend);
+            M t;
+            t.reserve(l1.size() + l2.size());
+            t.insert(std::end(t), std::begin(l1), std::end(l1));
+            t.insert(std::end(t), std::begin(l2), std::end(l2));
+            return t;
+        }
+
+        static M mappend(M &&l1, const M &l2) {
+            ALGEBRA_INSTRUMENT_SCOPE(mappend);
+            l1.insert(std::end(l1), std::begin(l2), std::end(l2));
+            return std::move(l1);
+        }
+
+        static M mappend(const M &l1, M &&l2) {
+            ALGEBRA_INSTRUMENT_SCOPE(mappend);
+            l2.insert(std::begin(l2), std::begin(l1), std::end(l1));
+            return std::move(l2);
+        }
+
+        static M mappend(M &&l1, M &&l2) {
+            ALGEBRA_INSTRUMENT_SCOPE(mappend);
+            l1.splice_back(std::move(l2));
+            return std::move(l1);
+        }
+
+        // n copies of `m`, in one buffer of the exact size.
+        static M stimes(std::size_t n, const M &m) {
+            ALGEBRA_INSTRUMENT_SCOPE(mappend);
+            M t;
+            t.reserve(n * m.size());
+            for (std::size_t i = 0; i < n; ++i) {
+                t.insert(std::end(t), std::begin(m), std::end(m));
+            }
+            return t;
+        }
+
+        static constexpr bool instance = true;
+    };
+
+    /**
+     * small_vector as functor, the result is presized to the input.
+     */
+    template <typename T, std::size_t N, typename A>
+    struct functor<small_vector<T, N, A>> {
+        template <typename U>
+        using _F = Rebind<small_vector<T, N, A>, U>;
+
+        template <typename Fn, typename U = ResultOf<Fn(T)>>
+        static _F<U> fmap(Fn &&fn, const _F<T> &container) {
+            ALGEBRA_INSTRUMENT_SCOPE(fmap);
+            _F<U> result;
+            result.reserve(container.size());
+            for (auto &e : container) {
+                result.emplace_back(fn(e));
+            }
+            return result;
+        }
+
+        template <typename Fn, typename U = ResultOf<Fn(T)>,
+                  typename = Requires<(!std::is_same<U, T>::value &&
+                                       !StorageCompatible<T, U>::value) ||
+                                      (std::is_same<U, T>::value &&
+                                       !std::is_copy_assignable<T>::value &&
+                                       !std::is_move_assignable<T>::value)>>
+        static _F<U> fmap(Fn &&fn, _F<T> &&container) {
+            ALGEBRA_INSTRUMENT_SCOPE(fmap);
+            _F<U> result;
+            result.reserve(container.size());
+            for (auto &e : container) {
+                result.emplace_back(fn(std::move(e)));
+            }
+            return result;
+        }
+
+        // Into the storage of the input, for elements of the same layout.
+        template <typename Fn, typename U = ResultOf<Fn(T)>, typename = void,
+                  typename = Requires<!std::is_same<U, T>::value &&
+                                      StorageCompatible<T, U>::value>>
+        static _F<U> fmap(Fn &&fn, _F<T> &&container) {
+            ALGEBRA_INSTRUMENT_SCOPE(fmap);
+            return std::move(container).template transmute<U>(fn);
+        }
+
+        // In place fmap.
+        template <typename Fn, typename U = ResultOf<Fn(T)>,
+                  typename = Requires<std::is_same<U, T>::value &&
+                                      (std::is_copy_assignable<T>::value ||
+                                       std::is_move_assignable<T>::value)>>
+        static _F<T> fmap(Fn &&fn, _F<T> &&container) {
+            ALGEBRA_INSTRUMENT_SCOPE(fmap);
+            for (auto &e : container) {
+                e = fn(std::move(e));
+            }
+            return std::move(container);
+        }
+
+        static constexpr bool instance = true;
+    };
+
+    /**
+     * small_vector as monad.
+     *
+     * `bind` appends every callback result straight into the output, no
+     * intermediate container of containers is built.
+     */
+    template <typename T, std::size_t N, typename A>
+    struct monad<small_vector<T, N, A>> : default_monad<small_vector<T, N, A>> {
+        template <typename U>
+        using _M = Rebind<small_vector<T, N, A>, U>;
+
+       private:
+        template <typename M, typename R>
+        static void append(M &result, const R &r) {
+            result.insert(std::end(result), std::begin(r), std::end(r));
+        }
+
+        template <typename M, typename R, typename = Requires<!std::is_lvalue_reference<R>::value>>
+        static void append(M &result, R &&r) {
+            result.insert(std::end(result), std::make_move_iterator(std::begin(r)),
+                          std::make_move_iterator(std::end(r)));
+        }
+
+        template <typename U, typename B>
+        static void append(small_vector<U, N, B> &result, small_vector<U, N, B> &&r) {
+            result.splice_back(std::move(r));
+        }
+
+       public:
+        template <typename F, typename R = ResultOf<F(T)>, typename U = ValueType<R>>
+        static _M<U> bind(const _M<T> &m, F &&f) {
+            ALGEBRA_INSTRUMENT_SCOPE(bind);
+            _M<U> result;
+            for (auto &e : m) {
+                append(result, f(e));
+            }
+            return result;
+        }
+
+        template <typename F, typename R = ResultOf<F(T)>, typename U = ValueType<R>>
+        static _M<U> bind(_M<T> &&m, F &&f) {
+            ALGEBRA_INSTRUMENT_SCOPE(bind);
+            _M<U> result;
+            for (auto &e : m) {
+                append(result, f(std::move(e)));
+            }
+            return result;
+        }
+    };
+
+    /**
+     * small_vector as foldable.
+     */
+    template <typename T, std::size_t N, typename A>
+    struct foldable<small_vector<T, N, A>> : default_foldable<small_vector<T, N, A>> {};
+};
+
+#endif /* __ALGEBRA_DATA_SMALL_VECTOR_HPP__ */
@@ -0,0 +1,401 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_DATA_SOA_VECTOR_HPP__
+#define __ALGEBRA_DATA_SOA_VECTOR_HPP__
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "../basic/type_concepts.hpp"
+#include "../basic/type_operation.hpp"
+#include "../control/functor.hpp"
+#include "../data/foldable.hpp"
+#include "../data/monoid.hpp"
+#include "../data/stl_container.hpp"
+
+/**
+ * Structure-of-arrays container: `soa_vector<std::tuple<Ts...>>` has the same
+ * interface as `std::vector<std::tuple<Ts...>>`, but stores every field in
+ * its own contiguous column.
+ *
+ * A function that only reads some fields can be wrapped by `project<Is...>`,
+ * then `fmap` and `foldMap` stream only the columns `Is...` and call the
+ * function with the field values directly, e.g.:
+ *
+ *      soa_vector<std::tuple<float, float, int>> v = ...;
+ *      auto r = project<0, 1>([](float x, float y) { return x * y; }) % v;
+ *
+ * `r` is a `std::vector<float>`: rebinding a `soa_vector` to a tuple type gives
+ * another `soa_vector`, rebinding it to any other type gives a plain column.
+ */
+namespace algebra {
+
+    /**
+     * A function on the fields `Is...` of a tuple. It can be applied to a tuple
+     * as an ordinary function, the columnar containers unwrap it and feed the
+     * fields from their columns.
+     */
+    template <typename Fn, std::size_t... Is>
+    struct projection {
+        Fn fn;
+
+        template <typename Tuple>
+        constexpr auto operator()(Tuple &&t) const
+                -> decltype(fn(std::get<Is>(std::forward<Tuple>(t))...)) {
+            return fn(std::get<Is>(std::forward<Tuple>(t))...);
+        }
+    };
+
+    template <std::size_t... Is, typename Fn>
+    constexpr projection<PlainType<Fn>, Is...> project(Fn &&fn) {
+        return projection<PlainType<Fn>, Is...>{std::forward<Fn>(fn)};
+    }
+
+    template <typename>
+    struct is_projection : std::false_type {};
+
+    template <typename Fn, std::size_t... Is>
+    struct is_projection<projection<Fn, Is...>> : std::true_type {};
+
+    template <typename Tuple>
+    class soa_vector;
+
+    template <typename... Ts>
+    class soa_vector<std::tuple<Ts...>> {
+       public:
+        using value_type = std::tuple<Ts...>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::tuple<Ts &...>;
+        using const_reference = std::tuple<const Ts &...>;
+
+        template <std::size_t I>
+        using column_type = std::vector<typename std::tuple_element<I, value_type>::type>;
+
+       private:
+        using indices = std::index_sequence_for<Ts...>;
+
+        std::tuple<std::vector<Ts>...> columns_;
+
+        // Apply `fn` to every column.
+        template <typename Fn, std::size_t... Is>
+        void each_column(Fn &&fn, std::index_sequence<Is...>) {
+            using expand = int[];
+            (void)expand{0, ((void)fn(std::get<Is>(columns_)), 0)...};
+        }
+
+        template <typename Tuple, std::size_t... Is>
+        void push_impl(Tuple &&t, std::index_sequence<Is...>) {
+            using expand = int[];
+            (void)expand{0, ((void)std::get<Is>(columns_).push_back(
+                                     std::get<Is>(std::forward<Tuple>(t))),
+                             0)...};
+        }
+
+        template <typename Tuple, std::size_t... Is>
+        void assign_impl(size_type i, Tuple &&t, std::index_sequence<Is...>) {
+            using expand = int[];
+            (void)expand{0, ((void)(std::get<Is>(columns_)[i] =
+                                            std::get<Is>(std::forward<Tuple>(t))),
+                             0)...};
+        }
+
+        template <std::size_t... Is>
+        reference at_impl(size_type i, std::index_sequence<Is...>) {
+            return reference(std::get<Is>(columns_)[i]...);
+        }
+
+        template <std::size_t... Is>
+        const_reference at_impl(size_type i, std::index_sequence<Is...>) const {
+            return const_reference(std::get<Is>(columns_)[i]...);
+        }
+
+       public:
+        /**
+         * Proxy iterator, dereferences to a tuple of references into the columns.
+         * It moves by its index, so it has the operations of random access,
+         * like the iterator of `std::vector<bool>`.
+         */
+        template <typename Vec, typename Ref>
+        class basic_iterator {
+            Vec *v_;
+            size_type i_;
+
+           public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::tuple<Ts...>;
+            using difference_type = std::ptrdiff_t;
+            using reference = Ref;
+            using pointer = void;
+
+            basic_iterator(Vec *v, size_type i) noexcept : v_(v), i_(i) {}
+
+            reference operator*() const { return (*v_)[i_]; }
+            reference operator[](difference_type n) const { return (*v_)[i_ + n]; }
+            basic_iterator &operator++() noexcept { return ++i_, *this; }
+            basic_iterator &operator--() noexcept { return --i_, *this; }
+            basic_iterator operator++(int) noexcept { return basic_iterator(v_, i_++); }
+            basic_iterator operator--(int) noexcept { return basic_iterator(v_, i_--); }
+            basic_iterator &operator+=(difference_type n) noexcept { return i_ += n, *this; }
+            basic_iterator &operator-=(difference_type n) noexcept { return i_ -= n, *this; }
+
+            basic_iterator operator+(difference_type n) const noexcept {
+                return basic_iterator(v_, i_ + n);
+            }
+
+            basic_iterator operator-(difference_type n) const noexcept {
+                return basic_iterator(v_, i_ - n);
+            }
+
+            friend basic_iterator operator+(difference_type n, const basic_iterator &it) noexcept {
+                return it + n;
+            }
+
+            difference_type operator-(const basic_iterator &o) const noexcept {
+                return difference_type(i_) - difference_type(o.i_);
+            }
+
+            bool operator==(const basic_iterator &o) const noexcept { return i_ == o.i_; }
+            bool operator!=(const basic_iterator &o) const noexcept { return i_ != o.i_; }
+            bool operator<(const basic_iterator &o) const noexcept { return i_ < o.i_; }
+            bool operator>(const basic_iterator &o) const noexcept { return i_ > o.i_; }
+            bool operator<=(const basic_iterator &o) const noexcept { return i_ <= o.i_; }
+            bool operator>=(const basic_iterator &o) const noexcept { return i_ >= o.i_; }
+        };
+
+        using iterator = basic_iterator<soa_vector, reference>;
+        using const_iterator = basic_iterator<const soa_vector, const_reference>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        /**
+         * Constructors.
+         */
+
+        soa_vector() = default;
+
+        explicit soa_vector(size_type n) : columns_(std::vector<Ts>(n)...) {}
+
+        soa_vector(std::initializer_list<value_type> l) {
+            reserve(l.size());
+            for (auto &e : l) {
+                push_back(e);
+            }
+        }
+
+        /**
+         * Columns.
+         */
+
+        template <std::size_t I>
+        column_type<I> &column() noexcept {
+            return std::get<I>(columns_);
+        }
+
+        template <std::size_t I>
+        const column_type<I> &column() const noexcept {
+            return std::get<I>(columns_);
+        }
+
+        /**
+         * Iterators.
+         */
+
+        iterator begin() noexcept { return iterator(this, 0); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        iterator end() noexcept { return iterator(this, size()); }
+        const_iterator end() const noexcept { return const_iterator(this, size()); }
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+        /**
+         * Capacity and element access.
+         */
+
+        size_type size() const noexcept { return std::get<0>(columns_).size(); }
+        bool empty() const noexcept { return size() == 0; }
+
+        void reserve(size_type n) {
+            each_column([n](auto &c) { c.reserve(n); }, indices{});
+        }
+
+        void resize(size_type n) {
+            each_column([n](auto &c) { c.resize(n); }, indices{});
+        }
+
+        void clear() noexcept {
+            each_column([](auto &c) { c.clear(); }, indices{});
+        }
+
+        reference operator[](size_type i) { return at_impl(i, indices{}); }
+        const_reference operator[](size_type i) const { return at_impl(i, indices{}); }
+
+        /**
+         * Modifiers.
+         */
+
+        void push_back(const value_type &t) { push_impl(t, indices{}); }
+        void push_back(value_type &&t) { push_impl(std::move(t), indices{}); }
+
+        template <typename... Args>
+        void emplace_back(Args &&... args) {
+            push_impl(std::forward_as_tuple(std::forward<Args>(args)...), indices{});
+        }
+
+        template <typename Tuple>
+        void assign(size_type i, Tuple &&t) {
+            assign_impl(i, std::forward<Tuple>(t), indices{});
+        }
+
+        friend bool operator==(const soa_vector &a, const soa_vector &b) {
+            return a.columns_ == b.columns_;
+        }
+
+        friend bool operator!=(const soa_vector &a, const soa_vector &b) { return !(a == b); }
+    };
+
+    namespace _inner_impl {
+        template <typename U>
+        struct soa_rebind {
+            using type = std::vector<U>;
+        };
+
+        template <typename... Us>
+        struct soa_rebind<std::tuple<Us...>> {
+            using type = soa_vector<std::tuple<Us...>>;
+        };
+
+        // Store a value into the presized result of a columnar map.
+        template <typename U>
+        void soa_store(std::vector<U> &r, std::size_t i, U &&u) {
+            r[i] = std::move(u);
+        }
+
+        template <typename... Us>
+        void soa_store(soa_vector<std::tuple<Us...>> &r, std::size_t i, std::tuple<Us...> &&u) {
+            r.assign(i, std::move(u));
+        }
+    };
+
+    // Specialize `Rebind` for `soa_vector`.
+    template <typename... Ts>
+    struct parametric_type_traits<soa_vector<std::tuple<Ts...>>> {
+        using value_type = std::tuple<Ts...>;
+
+        template <typename U>
+        using rebind = typename _inner_impl::soa_rebind<U>::type;
+    };
+
+    /**
+     * soa_vector as functor.
+     */
+    template <typename... Ts>
+    struct functor<soa_vector<std::tuple<Ts...>>> {
+        using T = std::tuple<Ts...>;
+
+        template <typename U>
+        using _F = Rebind<soa_vector<T>, U>;
+
+       private:
+        // The columns are passed as raw pointers so that the loop only touches
+        // the used fields.
+        template <typename Fn, typename R, typename... Cs>
+        static void map_columns(const Fn &fn, R &result, std::size_t n, const Cs *... cs) {
+            for (std::size_t i = 0; i < n; ++i) {
+                _inner_impl::soa_store(result, i, fn(cs[i]...));
+            }
+        }
+
+        // Into a plain column, in blocks of a fixed size like `map_contiguous`,
+        // that compilers vectorize for arithmetic functions.
+        template <typename Fn, typename U, typename... Cs>
+        static void map_columns(const Fn &fn, std::vector<U> &result, std::size_t n,
+                                const Cs *ALGEBRA_RESTRICT... cs) {
+            constexpr std::size_t block = 16;
+            U *ALGEBRA_RESTRICT out = result.data();
+            std::size_t i = 0;
+            for (; i + block <= n; i += block) {
+                for (std::size_t j = 0; j < block; ++j) {  // vectorized kernel
+                    out[i + j] = fn(cs[i + j]...);
+                }
+            }
+            for (; i < n; ++i) {
+                out[i] = fn(cs[i]...);
+            }
+        }
+
+       public:
+        template <typename Fn, typename U = ResultOf<Fn(T)>,
+                  typename = Requires<!is_projection<PlainType<Fn>>::value>>
+        static _F<U> fmap(Fn &&fn, const soa_vector<T> &f) {
+            _F<U> result;
+            result.reserve(f.size());
+            for (std::size_t i = 0; i < f.size(); ++i) {
+                result.push_back(fn(f[i]));
+            }
+            return result;
+        }
+
+        // Map a projection, only the projected columns are read.
+        template <typename Fn, std::size_t... Is,
+                  typename U = ResultOf<Fn(typename std::tuple_element<Is, T>::type...)>,
+                  typename = Requires<std::is_default_constructible<U>::value>>
+        static _F<U> fmap(const projection<Fn, Is...> &p, const soa_vector<T> &f) {
+            _F<U> result(f.size());
+            map_columns(p.fn, result, f.size(), f.template column<Is>().data()...);
+            return result;
+        }
+
+        static constexpr bool instance = true;
+    };
+
+    /**
+     * soa_vector as foldable.
+     */
+    template <typename... Ts>
+    struct foldable<soa_vector<std::tuple<Ts...>>>
+            : default_foldable<soa_vector<std::tuple<Ts...>>> {
+        using T = std::tuple<Ts...>;
+
+       private:
+        template <typename Fn, typename M, typename... Cs>
+        static M fold_columns(const Fn &fn, std::size_t n, const Cs *ALGEBRA_RESTRICT... cs) {
+            constexpr std::size_t block = 16;
+            M acc = monoid<M>::mempty();
+            std::size_t i = 0;
+            for (; i + block <= n; i += block) {
+                for (std::size_t j = 0; j < block; ++j) {  // vectorized kernel
+                    acc = monoid<M>::mappend(std::move(acc), fn(cs[i + j]...));
+                }
+            }
+            for (; i < n; ++i) {
+                acc = monoid<M>::mappend(std::move(acc), fn(cs[i]...));
+            }
+            return acc;
+        }
+
+       public:
+        template <typename Fn, typename M = ResultOf<Fn(T)>,
+                  typename = Requires<Monoid<M>::value && !is_projection<PlainType<Fn>>::value>>
+        static M foldMap(Fn &&fn, const soa_vector<T> &f) {
+            return default_foldable<soa_vector<T>>::foldMap(std::forward<Fn>(fn), f);
+        }
+
+        // Fold a projection, only the projected columns are read.
+        template <typename Fn, std::size_t... Is,
+                  typename M = ResultOf<Fn(typename std::tuple_element<Is, T>::type...)>,
+                  typename = Requires<Monoid<M>::value>>
+        static M foldMap(const projection<Fn, Is...> &p, const soa_vector<T> &f) {
+            return fold_columns<Fn, M>(p.fn, f.size(), f.template column<Is>().data()...);
+        }
+    };
+};
+
+#endif /* __ALGEBRA_DATA_SOA_VECTOR_HPP__ */
@@ -5,13 +5,29 @@
 #ifndef __ALGEBRA_H_DATA_LIST_HPP__
 #define __ALGEBRA_H_DATA_LIST_HPP__
 
+#include <array>
+#include <deque>
+#include <iterator>
 #include <list>
 #include <string>
+#include <utility>
 #include <vector>
+#include "../basic/instrument.hpp"
+#include "../control/alternative.hpp"
+#include "../control/applicative.hpp"
 #include "../control/functor.hpp"
 #include "../control/monad.hpp"
+#include "../data/foldable.hpp"
 #include "../data/monoid.hpp"
 
+#ifndef ALGEBRA_RESTRICT
+#if defined(__GNUC__) || defined(_MSC_VER)
+#define ALGEBRA_RESTRICT __restrict
+#else
+#define ALGEBRA_RESTRICT
+#endif
+#endif
+
 /**
  * Instantiate STL container as functional type classes.
  */
@@ -38,6 +54,94 @@ namespace algebra {
         using rebind = C<U, rebind_allocator<U>>;
     };
 
+    namespace _inner_impl {
+        // Reserve space if the container supports it, e.g., `std::vector`.
+        template <typename C>
+        auto try_reserve(C& c, std::size_t n, int) -> decltype(c.reserve(n), void()) {
+            c.reserve(n);
+        }
+
+        template <typename C>
+        void try_reserve(C&, std::size_t, long) {}
+
+        template <typename C>
+        void try_reserve(C& c, std::size_t n) {
+            try_reserve(c, n, 0);
+        }
+
+        // Move the elements of `from` to the end of `to`, in one insertion.
+        template <typename C, typename D>
+        void append_moved(C& to, D&& from) {
+            to.insert(std::end(to), std::make_move_iterator(std::begin(from)),
+                      std::make_move_iterator(std::end(from)));
+        }
+
+        // Lists are spliced, without moving any element.
+        template <typename T, typename A>
+        void append_moved(std::list<T, A>& to, std::list<T, A>&& from) {
+            if (to.get_allocator() == from.get_allocator()) {
+                to.splice(std::end(to), from);
+            } else {
+                to.insert(std::end(to), std::make_move_iterator(std::begin(from)),
+                          std::make_move_iterator(std::end(from)));
+            }
+        }
+
+        // Characters needn't be moved, and a string may copy a range of move
+        // iterators into a temporary before inserting it.
+        template <typename... Ts>
+        void append_moved(std::basic_string<Ts...>& to, std::basic_string<Ts...>&& from) {
+            to.append(from);
+        }
+
+        // Erase the elements that don't satisfy `p`, in place.
+        template <typename C, typename P>
+        void retain_if(C& c, P& p) {
+            using T = typename C::value_type;
+            c.erase(std::remove_if(std::begin(c), std::end(c), [&p](const T& x) { return !p(x); }),
+                    std::end(c));
+        }
+
+        // Lists unlink the nodes, without moving any element.
+        template <typename T, typename A, typename P>
+        void retain_if(std::list<T, A>& c, P& p) {
+            c.remove_if([&p](const T& x) { return !p(x); });
+        }
+
+        // Vectors other than `std::vector<bool>` store their elements in an array.
+        template <typename C>
+        struct is_contiguous_vector : std::false_type {};
+
+        template <typename T, typename A>
+        struct is_contiguous_vector<std::vector<T, A>>
+                : std::integral_constant<bool, !std::is_same<T, bool>::value> {};
+
+        // The `fmap` kernel over arrays, appending to the vector `out`: counted
+        // loops without capacity checks, that compilers vectorize for arithmetic
+        // functions. The blocks of a fixed size are vectorized even by the cost
+        // models that don't vectorize loops needing a scalar epilogue, like
+        // the one of GCC at -O2. A block is mapped into a buffer on the stack,
+        // then appended, so the result isn't zero filled by a first pass over
+        // the memory.
+        template <typename Fn, typename T, typename V>
+        void map_contiguous(Fn& fn, const T* ALGEBRA_RESTRICT in, std::size_t n, V& out) {
+            using U = typename V::value_type;
+            constexpr std::size_t block = 16;
+            U buffer[block];
+            out.reserve(out.size() + n);
+            std::size_t i = 0;
+            for (; i + block <= n; i += block) {
+                for (std::size_t j = 0; j < block; ++j) {  // vectorized kernel
+                    buffer[j] = fn(in[i + j]);
+                }
+                out.insert(out.end(), buffer, buffer + block);
+            }
+            for (; i < n; ++i) {
+                out.push_back(fn(in[i]));
+            }
+        }
+    };
+
     /**
      * STL containers as monoid.
      */
@@ -46,26 +150,43 @@ namespace algebra {
         static M mempty() { return M{}; }
 
         static M mappend(const M& l1, const M& l2) {
-            M t = l1;
+            ALGEBRA_INSTRUMENT_SCOPE(mappend);
+            M t;
+            _inner_impl::try_reserve(t, l1.size() + l2.size());
+            t.insert(std::end(t), std::begin(l1), std::end(l1));
             t.insert(std::end(t), std::begin(l2), std::end(l2));
             return t;
         }
 
         static M mappend(M&& l1, const M& l2) {
+            ALGEBRA_INSTRUMENT_SCOPE(mappend);
             l1.insert(std::end(l1), std::begin(l2), std::end(l2));
             return std::move(l1);
         }
 
         static M mappend(const M& l1, M&& l2) {
+            ALGEBRA_INSTRUMENT_SCOPE(mappend);
             l2.insert(std::begin(l2), std::begin(l1), std::end(l1));
             return std::move(l2);
         }
 
         static M mappend(M&& l1, M&& l2) {
-            std::move(std::begin(l2), std::end(l2), std::back_inserter(l1));
+            ALGEBRA_INSTRUMENT_SCOPE(mappend);
+            _inner_impl::append_moved(l1, std::move(l2));
             return std::move(l1);
         }
 
+        // n copies of `m`, in one buffer of the exact size.
+        static M stimes(std::size_t n, const M& m) {
+            ALGEBRA_INSTRUMENT_SCOPE(mappend);
+            M t;
+            _inner_impl::try_reserve(t, n * m.size());
+            for (std::size_t i = 0; i < n; ++i) {
+                t.insert(std::end(t), std::begin(m), std::end(m));
+            }
+            return t;
+        }
+
         static constexpr bool instance = true;
     };
 
@@ -79,28 +200,58 @@ namespace algebra {
         template <typename U>
         using _F = Rebind<F, U>;
 
-        template <typename Fn, typename U = ResultOf<Fn(T)>,
-                  typename = Requires<!std::is_same<U, T>::value ||
-                                      (!std::is_copy_assignable<T>::value &&
-                                       !std::is_move_assignable<T>::value)>>
-        static _F<U> fmap(Fn&& fn, const _F<T>& container) {
+       private:
+        // Vectors of trivial types are mapped by a vectorizable kernel. Elements
+        // are read as const, moving them is copying.
+        template <typename U>
+        using contiguous = std::integral_constant<
+                bool, _inner_impl::is_contiguous_vector<_F<T>>::value &&
+                              _inner_impl::is_contiguous_vector<_F<U>>::value &&
+                              std::is_trivially_copyable<T>::value &&
+                              std::is_trivially_default_constructible<U>::value &&
+                              std::is_trivially_copy_assignable<U>::value>;
+
+        template <typename U, typename Fn>
+        static _F<U> map(Fn& fn, const _F<T>& container, std::true_type) {
+            _F<U> result;
+            _inner_impl::map_contiguous(fn, container.data(), container.size(), result);
+            return result;
+        }
+
+        template <typename U, typename Fn>
+        static _F<U> map(Fn& fn, const _F<T>& container, std::false_type) {
             _F<U> result;
+            _inner_impl::try_reserve(result, container.size());
+            for (auto& e : container) {
+                result.emplace_back(fn(e));
+            }
+            return result;
+        }
+
+        template <typename U, typename Fn>
+        static _F<U> map(Fn& fn, _F<T>&& container, std::false_type) {
+            _F<U> result;
+            _inner_impl::try_reserve(result, container.size());
             for (auto& e : container) {
                 result.emplace_back(fn(std::move(e)));
             }
             return result;
         }
 
+       public:
+        template <typename Fn, typename U = ResultOf<Fn(T)>>
+        static _F<U> fmap(Fn&& fn, const _F<T>& container) {
+            ALGEBRA_INSTRUMENT_SCOPE(fmap);
+            return map<U>(fn, container, contiguous<U>{});
+        }
+
         template <typename Fn, typename U = ResultOf<Fn(T)>,
                   typename = Requires<!std::is_same<U, T>::value ||
                                       (!std::is_copy_assignable<T>::value &&
                                        !std::is_move_assignable<T>::value)>>
         static _F<U> fmap(Fn&& fn, _F<T>&& container) {
-            _F<U> result;
-            for (auto& e : container) {
-                result.emplace_back(fn(std::move(e)));
-            }
-            return result;
+            ALGEBRA_INSTRUMENT_SCOPE(fmap);
+            return map<U>(fn, std::move(container), contiguous<U>{});
         }
 
         // In place fmap.
@@ -109,16 +260,172 @@ namespace algebra {
                                       (std::is_copy_assignable<T>::value ||
                                        std::is_move_assignable<T>::value)>>
         static _F<T> fmap(Fn&& fn, _F<T>&& container) {
-            // for (auto &e :container) {
-            //     e = fn(std::move(e));
-            // }
-            std::transform(std::begin(container), std::end(container), std::begin(container), fn);
-            return container;
+            ALGEBRA_INSTRUMENT_SCOPE(fmap);
+            for (auto& e : container) {
+                e = fn(std::move(e));
+            }
+            return std::move(container);
         }
 
         static constexpr bool instance = true;
     };
 
+    /**
+     * A lazy view of `n` copies of a container, the result of `>>` on sequence
+     * containers. It can be traversed and folded without materialization, and
+     * converts to the container itself by filling one buffer of the exact size.
+     */
+    template <typename M>
+    class repeated {
+        std::size_t n_;
+        M m_;
+
+        void fill(M& result) const {
+            _inner_impl::try_reserve(result, size());
+            for (std::size_t i = 0; i < n_; ++i) {
+                result.insert(std::end(result), std::begin(m_), std::end(m_));
+            }
+        }
+
+       public:
+        using value_type = ValueType<M>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = typename M::const_reference;
+        using const_reference = typename M::const_reference;
+
+        class const_iterator {
+            const M* m_;
+            typename M::const_iterator it_;
+            std::size_t k_;  // number of the remaining copies.
+
+           public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = ValueType<M>;
+            using difference_type = std::ptrdiff_t;
+            using reference = typename M::const_reference;
+            using pointer = typename M::const_pointer;
+
+            const_iterator(const M* m, std::size_t k) : m_(m), it_(std::begin(*m)), k_(k) {
+                if (it_ == std::end(*m_)) {
+                    k_ = 0;
+                }
+            }
+
+            reference operator*() const { return *it_; }
+
+            const_iterator& operator++() {
+                if (++it_ == std::end(*m_) && --k_ != 0) {
+                    it_ = std::begin(*m_);
+                }
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator t = *this;
+                ++*this;
+                return t;
+            }
+
+            bool operator==(const const_iterator& o) const {
+                return k_ == o.k_ && (k_ == 0 || it_ == o.it_);
+            }
+
+            bool operator!=(const const_iterator& o) const { return !(*this == o); }
+        };
+
+        using iterator = const_iterator;
+
+        repeated(std::size_t n, M m) : n_(n), m_(std::move(m)) {}
+
+        // Number of copies and the repeated container.
+        std::size_t count() const noexcept { return n_; }
+        const M& base() const noexcept { return m_; }
+
+        size_type size() const { return n_ * m_.size(); }
+        bool empty() const { return n_ == 0 || m_.empty(); }
+
+        const_iterator begin() const { return const_iterator(&m_, n_); }
+        const_iterator end() const { return const_iterator(&m_, 0); }
+
+        M materialize() const& {
+            M result;
+            fill(result);
+            return result;
+        }
+
+        M materialize() && {
+            if (n_ == 1) {
+                return std::move(m_);
+            }
+            M result;
+            fill(result);
+            return result;
+        }
+
+        operator M() const& { return materialize(); }
+        operator M() && { return std::move(*this).materialize(); }
+
+        friend bool operator==(const repeated& r, const M& m) {
+            return r.size() == m.size() && std::equal(r.begin(), r.end(), std::begin(m));
+        }
+
+        friend bool operator==(const M& m, const repeated& r) { return r == m; }
+        friend bool operator!=(const repeated& r, const M& m) { return !(r == m); }
+        friend bool operator!=(const M& m, const repeated& r) { return !(r == m); }
+    };
+
+    // Specialize `Rebind` for `repeated`, rebind the repeated container.
+    template <typename M>
+    struct parametric_type_traits<repeated<M>> {
+        using value_type = ValueType<M>;
+
+        template <typename U>
+        using rebind = repeated<Rebind<M, U>>;
+    };
+
+    /**
+     * fmap f (n copies of m) = n copies of (fmap f m), `f` is applied |m| times.
+     */
+    template <typename M>
+    struct functor<repeated<M>> {
+        using T = ValueType<M>;
+
+        template <typename U>
+        using _F = repeated<Rebind<M, U>>;
+
+        template <typename Fn, typename U = ResultOf<Fn(T)>>
+        static _F<U> fmap(Fn&& fn, const repeated<M>& r) {
+            ALGEBRA_INSTRUMENT_SCOPE(fmap);
+            return _F<U>(r.count(), functor<M>::fmap(std::forward<Fn>(fn), r.base()));
+        }
+
+        static constexpr bool instance = true;
+    };
+
+    /**
+     * foldMap f (n copies of m) = stimes n (foldMap f m), `f` is applied |m|
+     * times and the copies take O(log n) `mappend`s. `foldl` and `foldr`
+     * stream over the copies.
+     */
+    template <typename M>
+    struct foldable<repeated<M>> : default_foldable<repeated<M>> {
+        using T = ValueType<M>;
+
+        template <typename Fn, typename R = ResultOf<Fn(T)>, typename = Requires<Monoid<R>::value>>
+        static R foldMap(Fn&& fn, const repeated<M>& r) {
+            return stimes(r.count(), foldable<M>::foldMap(std::forward<Fn>(fn), r.base()));
+        }
+
+        template <typename Fn, typename B>
+        static B foldr(Fn&& fn, B z, const repeated<M>& r) {
+            for (std::size_t i = 0; i < r.count(); ++i) {
+                z = foldable<M>::foldr(fn, std::move(z), r.base());
+            }
+            return z;
+        }
+    };
+
     /**
      * STL containers as monad.
      */
@@ -129,29 +436,166 @@ namespace algebra {
         template <typename U>
         using _M = Rebind<M, U>;
 
-        template <typename F, typename R = ResultOf<F(T)>, typename U = ValueType<R>,
-                  typename = Requires<DefaultConstructible<_M<U>>::value>>
-        static _M<U> bind(const _M<T>& m, F&& f) {
-            auto r = std::forward<F>(f) % m;
+       private:
+        template <typename MM>
+        static std::size_t total_size(const MM& mm) {
+            std::size_t n = 0;
+            for (auto& e : mm) {
+                n += e.size();
+            }
+            return n;
+        }
+
+        // Take the storage of a result of the same type, else move its elements.
+        template <typename R>
+        static void adopt(R& result, R&& e) {
+            result = std::move(e);
+        }
+
+        template <typename R, typename E>
+        static void adopt(R& result, E&& e) {
+            _inner_impl::append_moved(result, std::forward<E>(e));
+        }
+
+        // Concatenate the containers in `mm`, which is consumed, into a result
+        // allocated once. Empty containers, the pruned branches of a search,
+        // are skipped: when none is left nothing is allocated, and a single
+        // one left is moved as the result.
+        template <typename U, typename MM>
+        static _M<U> flatten(MM&& mm) {
+            std::size_t total = 0, nonempty = 0;
+            auto last = std::end(mm);
+            for (auto it = std::begin(mm); it != std::end(mm); ++it) {
+                if (!it->empty()) {
+                    total += it->size();
+                    ++nonempty;
+                    last = it;
+                }
+            }
             _M<U> result;
-            auto it = std::inserter(result, std::begin(result));
-            for (auto& e : r) {
-                it = std::move(std::begin(e), std::end(e), it);
+            if (nonempty == 1) {
+                adopt(result, std::move(*last));
+                return result;
+            }
+            _inner_impl::try_reserve(result, total);
+            for (auto& e : mm) {
+                if (!e.empty()) {
+                    _inner_impl::append_moved(result, std::move(e));
+                }
             }
             return result;
         }
 
+       public:
+        template <typename F, typename R = ResultOf<F(T)>, typename U = ValueType<R>,
+                  typename = Requires<DefaultConstructible<_M<U>>::value>>
+        static _M<U> bind(const _M<T>& m, F&& f) {
+            ALGEBRA_INSTRUMENT_SCOPE(bind);
+            return flatten<U>(std::forward<F>(f) % m);
+        }
+
         template <typename F, typename R = ResultOf<F(T)>, typename U = ValueType<R>,
                   typename = Requires<DefaultConstructible<_M<U>>::value>>
         static _M<U> bind(_M<T>&& m, F&& f) {
-            auto r = std::forward<F>(f) % std::move(m);
+            ALGEBRA_INSTRUMENT_SCOPE(bind);
+            return flatten<U>(std::forward<F>(f) % std::move(m));
+        }
+
+        static _M<T> join(const _M<_M<T>>& m) {
+            ALGEBRA_INSTRUMENT_SCOPE(join);
+            _M<T> result;
+            _inner_impl::try_reserve(result, total_size(m));
+            for (auto& e : m) {
+                result.insert(std::end(result), std::begin(e), std::end(e));
+            }
+            return result;
+        }
+
+        static _M<T> join(_M<_M<T>>&& m) {
+            ALGEBRA_INSTRUMENT_SCOPE(join);
+            return flatten<T>(std::move(m));
+        }
+
+        // For sequences `ma >> mb` is |ma| copies of `mb`, the copies are made
+        // lazily by `repeated`.
+        template <typename MA, typename MB, typename _MB = PlainType<MB>>
+        static repeated<_MB> then(MA&& ma, MB&& mb) {
+            return repeated<_MB>(ma.size(), std::forward<MB>(mb));
+        }
+
+        // Apply every function to every value directly, without the nested binds
+        // of `default_ap`. When the functions are all of one closure type (rather
+        // than `std::function`) the call is inlined.
+        template <typename MF, typename _MF = PlainType<MF>, typename F = ValueType<_MF>,
+                  typename U = ResultOf<F(T)>>
+        static _M<U> ap(MF&& fs, const _M<T>& m) {
+            ALGEBRA_INSTRUMENT_SCOPE(ap);
             _M<U> result;
-            auto it = std::inserter(result, std::begin(result));
-            for (auto& e : r) {
-                it = std::move(std::begin(e), std::end(e), it);
+            _inner_impl::try_reserve(result, fs.size() * m.size());
+            for (auto& fn : fs) {
+                for (auto& e : m) {
+                    result.emplace_back(fn(e));
+                }
+            }
+            return result;
+        }
+    };
+
+    /**
+     * STL containers as foldable.
+     */
+    template <typename F>
+    struct foldable<stl_container<F>> : default_foldable<F> {};
+
+    /**
+     * STL containers as alternative, the choice is the concatenation.
+     */
+    template <typename F>
+    struct alternative<stl_container<F>> {
+        static F empty() { return F{}; }
+
+        template <typename FA, typename FB>
+        static F alt(FA&& a, FB&& b) {
+            return monoid<F>::mappend(std::forward<FA>(a), std::forward<FB>(b));
+        }
+
+        static constexpr bool instance = true;
+    };
+
+    /**
+     * STL containers as monad_plus. On rvalues, `guard` and `mfilter` work in
+     * place: a failed guard clears the container, keeping its storage, and
+     * `mfilter` compacts the retained elements with erase-remove.
+     */
+    template <typename M>
+    struct monad_plus<stl_container<M>> : default_monad_plus<M> {
+        using T = ValueType<M>;
+
+        static M guard(bool c, const M& m) { return c ? m : M{}; }
+
+        static M guard(bool c, M&& m) {
+            if (!c) {
+                m.clear();
+            }
+            return std::move(m);
+        }
+
+        template <typename P>
+        static M mfilter(P&& p, const M& m) {
+            M result;
+            for (auto& e : m) {
+                if (p(e)) {
+                    result.push_back(e);
+                }
             }
             return result;
         }
+
+        template <typename P>
+        static M mfilter(P&& p, M&& m) {
+            _inner_impl::retain_if(m, p);
+            return std::move(m);
+        }
     };
 
     /**
@@ -164,6 +608,12 @@ namespace algebra {
     struct functor<std::list<T, A>> : functor<stl_container<std::list<T, A>>> {};
     template <typename T, typename A>
     struct monad<std::list<T, A>> : monad<stl_container<std::list<T, A>>> {};
+    template <typename T, typename A>
+    struct foldable<std::list<T, A>> : foldable<stl_container<std::list<T, A>>> {};
+    template <typename T, typename A>
+    struct alternative<std::list<T, A>> : alternative<stl_container<std::list<T, A>>> {};
+    template <typename T, typename A>
+    struct monad_plus<std::list<T, A>> : monad_plus<stl_container<std::list<T, A>>> {};
 
     /**
      * For `std::vector`.
@@ -175,6 +625,168 @@ namespace algebra {
     struct functor<std::vector<T, A>> : functor<stl_container<std::vector<T, A>>> {};
     template <typename T, typename A>
     struct monad<std::vector<T, A>> : monad<stl_container<std::vector<T, A>>> {};
+    template <typename T, typename A>
+    struct foldable<std::vector<T, A>> : foldable<stl_container<std::vector<T, A>>> {};
+    template <typename T, typename A>
+    struct alternative<std::vector<T, A>> : alternative<stl_container<std::vector<T, A>>> {};
+    template <typename T, typename A>
+    struct monad_plus<std::vector<T, A>> : monad_plus<stl_container<std::vector<T, A>>> {};
+
+    /**
+     * For `std::deque`.
+     */
+
+    template <typename T, typename A>
+    struct monoid<std::deque<T, A>> : monoid<stl_container<std::deque<T, A>>> {
+        using M = std::deque<T, A>;
+        using monoid<stl_container<M>>::mappend;
+
+        // A deque grows block by block at both ends, so move the shorter operand
+        // onto the longer one with a single range insertion.
+        static M mappend(M&& l1, M&& l2) {
+            ALGEBRA_INSTRUMENT_SCOPE(mappend);
+            if (l1.size() < l2.size()) {
+                l2.insert(std::begin(l2), std::make_move_iterator(std::begin(l1)),
+                          std::make_move_iterator(std::end(l1)));
+                return std::move(l2);
+            }
+            l1.insert(std::end(l1), std::make_move_iterator(std::begin(l2)),
+                      std::make_move_iterator(std::end(l2)));
+            return std::move(l1);
+        }
+    };
+    template <typename T, typename A>
+    struct functor<std::deque<T, A>> : functor<stl_container<std::deque<T, A>>> {};
+    template <typename T, typename A>
+    struct monad<std::deque<T, A>> : monad<stl_container<std::deque<T, A>>> {};
+    template <typename T, typename A>
+    struct foldable<std::deque<T, A>> : foldable<stl_container<std::deque<T, A>>> {};
+    template <typename T, typename A>
+    struct alternative<std::deque<T, A>> : alternative<stl_container<std::deque<T, A>>> {};
+    template <typename T, typename A>
+    struct monad_plus<std::deque<T, A>> : monad_plus<stl_container<std::deque<T, A>>> {};
+
+    /**
+     * For `std::array`.
+     *
+     * The size is part of the type, so `fmap` and `ap` build the result array
+     * directly from an index sequence, without any allocation. `ap` is the
+     * zip-wise application (the i-th function to the i-th value) and `pure`
+     * replicates the value, which is the lawful applicative for fixed-size
+     * vectors.
+     *
+     * `fmap`, `pure`, `ap` and the folds are `constexpr`, so tables can be built
+     * at compile time from functions that are `constexpr` themselves (function
+     * objects with a `constexpr` call operator, or lambdas since C++17). Elements
+     * are accessed by `std::get`, as `operator[]` is `constexpr` on const arrays
+     * only before C++17. For the list monad over a fixed number of elements, see
+     * `fixed_list`.
+     */
+
+    template <typename T, std::size_t N>
+    struct functor<std::array<T, N>> {
+        template <typename U>
+        using _F = std::array<U, N>;
+
+       private:
+        template <typename Fn, typename U, std::size_t... I>
+        static constexpr _F<U> fmap_impl(Fn& fn, const _F<T>& f, std::index_sequence<I...>) {
+            return _F<U>{{fn(std::get<I>(f))...}};
+        }
+
+        template <typename Fn, typename U, std::size_t... I>
+        static constexpr _F<U> fmap_impl(Fn& fn, _F<T>&& f, std::index_sequence<I...>) {
+            return _F<U>{{fn(std::get<I>(std::move(f)))...}};
+        }
+
+       public:
+        template <typename Fn, typename U = ResultOf<Fn(T)>>
+        static constexpr _F<U> fmap(Fn&& fn, const _F<T>& f) {
+            return fmap_impl<Fn, U>(fn, f, std::make_index_sequence<N>{});
+        }
+
+        template <typename Fn, typename U = ResultOf<Fn(T)>>
+        static constexpr _F<U> fmap(Fn&& fn, _F<T>&& f) {
+            return fmap_impl<Fn, U>(fn, std::move(f), std::make_index_sequence<N>{});
+        }
+
+        static constexpr bool instance = true;
+    };
+
+    template <typename T, std::size_t N>
+    struct applicative<std::array<T, N>, void> {
+        template <typename U>
+        using _F = std::array<U, N>;
+
+       private:
+        template <std::size_t... I>
+        static constexpr _F<T> pure_impl(const T& x, std::index_sequence<I...>) {
+            return _F<T>{{((void)I, x)...}};
+        }
+
+        template <typename Ff, typename U, typename F, std::size_t... I>
+        static constexpr _F<U> ap_impl(Ff&& fn, F&& f, std::index_sequence<I...>) {
+            return _F<U>{{std::get<I>(fn)(std::get<I>(std::forward<F>(f)))...}};
+        }
+
+       public:
+        static constexpr _F<T> pure(const T& x) {
+            return pure_impl(x, std::make_index_sequence<N>{});
+        }
+
+        template <typename Ff, typename Fn = ValueType<PlainType<Ff>>, typename U = ResultOf<Fn(T)>>
+        static constexpr _F<U> ap(Ff&& fn, const _F<T>& f) {
+            return ap_impl<Ff, U>(std::forward<Ff>(fn), f, std::make_index_sequence<N>{});
+        }
+
+        template <typename Ff, typename Fn = ValueType<PlainType<Ff>>, typename U = ResultOf<Fn(T)>>
+        static constexpr _F<U> ap(Ff&& fn, _F<T>&& f) {
+            return ap_impl<Ff, U>(std::forward<Ff>(fn), std::move(f),
+                                  std::make_index_sequence<N>{});
+        }
+
+        template <typename Fn, typename U = ResultOf<Fn(T)>>
+        static constexpr _F<U> liftA(Fn&& fn, const _F<T>& f) {
+            return functor<_F<T>>::fmap(std::forward<Fn>(fn), f);
+        }
+
+        template <typename Fn, typename U = ResultOf<Fn(T)>>
+        static constexpr _F<U> liftA(Fn&& fn, _F<T>&& f) {
+            return functor<_F<T>>::fmap(std::forward<Fn>(fn), std::move(f));
+        }
+
+        static constexpr bool instance = true;
+    };
+
+    template <typename T, std::size_t N>
+    struct foldable<std::array<T, N>> {
+        template <typename Fn, typename B>
+        static constexpr B foldr(Fn&& fn, B z, const std::array<T, N>& f) {
+            for (std::size_t i = N; i > 0; --i) {
+                z = fn(f[i - 1], std::move(z));
+            }
+            return z;
+        }
+
+        template <typename Fn, typename B>
+        static constexpr B foldl(Fn&& fn, B z, const std::array<T, N>& f) {
+            for (std::size_t i = 0; i < N; ++i) {
+                z = fn(std::move(z), f[i]);
+            }
+            return z;
+        }
+
+        template <typename Fn, typename M = ResultOf<Fn(T)>, typename = Requires<Monoid<M>::value>>
+        static constexpr M foldMap(Fn&& fn, const std::array<T, N>& f) {
+            M acc = monoid<M>::mempty();
+            for (std::size_t i = 0; i < N; ++i) {
+                acc = monoid<M>::mappend(std::move(acc), fn(f[i]));
+            }
+            return acc;
+        }
+
+        static constexpr bool instance = true;
+    };
 
     /**
      * For `std::basic_string`
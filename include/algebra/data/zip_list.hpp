@@ -0,0 +1,335 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+#ifndef __ALGEBRA_DATA_ZIP_LIST_HPP__
+#define __ALGEBRA_DATA_ZIP_LIST_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../basic/instrument.hpp"
+#include "../basic/type_concepts.hpp"
+#include "../basic/type_operation.hpp"
+#include "../control/applicative.hpp"
+#include "../control/functor.hpp"
+#include "../data/foldable.hpp"
+#include "../data/stl_container.hpp"
+
+/**
+ * ZipList: the applicative of sequences that combines them elementwise, the
+ * i-th function applied to the i-th value, rather than every function to every
+ * value like the list monad does. `pure x` is `x` repeated forever, stored
+ * once, and the length of a combination is the one of its shortest operand.
+ *
+ * e.g.:
+ *      zip_list<float> price{...}, quantity{...}, fee{...};
+ *      auto total = price * quantity + fee;
+ *      auto net = fma(price, quantity, applicative<zip_list<float>>::pure(-1.5f));
+ *      auto ratio = liftA2([](float a, float b) { return a / (a + b); }, price, fee);
+ *
+ * The elements are stored in a `std::vector`. Combining trivially copyable
+ * elements into trivial results is one pass over arrays, into a result
+ * allocated once: a counted loop in blocks of a fixed size, which compilers
+ * vectorize for arithmetic. The operators `+ - * /` and `fma` on arithmetic
+ * elements are such kernels. `fma` is rounded once when the target has fused
+ * multiply-add instructions (`__FMA__`, e.g. `-mfma` or `-march=native`),
+ * else it's a multiplication then an addition.
+ */
+namespace algebra {
+
+    template <typename T>
+    class zip_list {
+        std::vector<T> xs_;
+        bool repeated_ = false;
+
+       public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using const_iterator = typename std::vector<T>::const_iterator;
+        using iterator = const_iterator;
+
+        zip_list() = default;
+        zip_list(std::initializer_list<T> xs) : xs_(xs) {}
+        explicit zip_list(std::vector<T> xs) : xs_(std::move(xs)) {}
+
+        // `x` repeated forever.
+        static zip_list repeat(T x) {
+            zip_list z;
+            z.xs_.push_back(std::move(x));
+            z.repeated_ = true;
+            return z;
+        }
+
+        // Whether the list is a single value repeated forever.
+        bool infinite() const noexcept { return repeated_; }
+
+        // The number of stored elements: 1 for an infinite list.
+        size_type size() const noexcept { return xs_.size(); }
+
+        bool empty() const noexcept { return xs_.empty(); }
+
+        const T *data() const noexcept { return xs_.data(); }
+
+        const_iterator begin() const noexcept { return xs_.begin(); }
+        const_iterator end() const noexcept { return xs_.end(); }
+
+        const T &operator[](size_type i) const noexcept { return xs_[repeated_ ? 0 : i]; }
+
+        const std::vector<T> &get() const & noexcept { return xs_; }
+        std::vector<T> get() && noexcept { return std::move(xs_); }
+
+        bool operator==(const zip_list &other) const {
+            return repeated_ == other.repeated_ && xs_ == other.xs_;
+        }
+        bool operator!=(const zip_list &other) const { return !(*this == other); }
+    };
+
+    namespace _inner_impl {
+        // An operand of a kernel: an array, or a value repeated forever.
+        template <typename T, bool Repeated>
+        struct lane {
+            const T *p;
+
+            const T &operator[](std::size_t i) const { return p[Repeated ? 0 : i]; }
+        };
+
+        // Call `k` with the lane of `z`.
+        template <typename T, typename K>
+        void with_lane(const zip_list<T> &z, K &&k) {
+            if (z.infinite()) {
+                k(lane<T, true>{z.data()});
+            } else {
+                k(lane<T, false>{z.data()});
+            }
+        }
+
+        // Call `k` with the lanes of all the lists, each kind of lane is a
+        // distinct instantiation of the kernel.
+        template <typename K>
+        void with_lanes(K &&k) {
+            k();
+        }
+
+        template <typename K, typename T, typename... Ts>
+        void with_lanes(K &&k, const zip_list<T> &z, const zip_list<Ts> &... zs) {
+            with_lane(z, [&](auto l) { with_lanes([&](auto... ls) { k(l, ls...); }, zs...); });
+        }
+
+        // The elementwise kernel on a block: `out[j] = fn(ls[i + j]...)`.
+        template <std::size_t Block, typename Fn, typename U, typename... Ls>
+        void zip_block(Fn &fn, std::size_t i, U *ALGEBRA_RESTRICT out, Ls... ls) {
+            for (std::size_t j = 0; j < Block; ++j) {  // vectorized kernel
+                out[j] = fn(ls[i + j]...);
+            }
+        }
+
+        // Appends `fn(ls[i]...)` to `out`, in blocks of a fixed size through a
+        // buffer on the stack like `map_contiguous`.
+        template <typename Fn, typename U, typename... Ls>
+        void zip_contiguous(Fn &fn, std::size_t n, std::vector<U> &out, Ls... ls) {
+            constexpr std::size_t block = 16;
+            U buffer[block];
+            out.reserve(n);
+            std::size_t i = 0;
+            for (; i + block <= n; i += block) {
+                zip_block<block>(fn, i, buffer, ls...);
+                out.insert(out.end(), buffer, buffer + block);
+            }
+            for (; i < n; ++i) {
+                out.push_back(fn(ls[i]...));
+            }
+        }
+
+        template <bool...>
+        struct bool_pack;
+
+        template <bool... Bs>
+        using all_true = std::is_same<bool_pack<true, Bs...>, bool_pack<Bs..., true>>;
+
+        // Trivially copyable elements combined into trivial results use the
+        // kernel.
+        template <typename U, typename... Ts>
+        using zip_contiguous_ok = std::integral_constant<
+                bool, all_true<std::is_trivially_copyable<Ts>::value...>::value &&
+                              std::is_trivially_default_constructible<U>::value &&
+                              std::is_trivially_copy_assignable<U>::value>;
+
+        // The length of a combination, the shortest of the finite operands, and
+        // whether it is infinite, when all the operands are.
+        template <typename... Ts>
+        std::pair<std::size_t, bool> zip_length(const zip_list<Ts> &... zs) {
+            std::size_t n = 1;
+            bool infinite = true;
+            for (auto z : {std::make_pair(zs.size(), zs.infinite())...}) {
+                if (!z.second) {
+                    n = infinite ? z.first : std::min(n, z.first);
+                    infinite = false;
+                }
+            }
+            return {n, infinite};
+        }
+
+        template <typename U, typename Fn, typename... Ts>
+        zip_list<U> zip_with(std::true_type, Fn &fn, const zip_list<Ts> &... zs) {
+            auto length = zip_length(zs...);
+            std::vector<U> result;
+            std::size_t n = length.first;
+            with_lanes([&](auto... ls) { zip_contiguous(fn, n, result, ls...); }, zs...);
+            return length.second ? zip_list<U>::repeat(result[0])
+                                 : zip_list<U>(std::move(result));
+        }
+
+        template <typename U, typename Fn, typename... Ts>
+        zip_list<U> zip_with(std::false_type, Fn &fn, const zip_list<Ts> &... zs) {
+            auto length = zip_length(zs...);
+            std::vector<U> result;
+            result.reserve(length.first);
+            for (std::size_t i = 0; i < length.first; ++i) {
+                result.emplace_back(fn(zs[i]...));
+            }
+            return length.second ? zip_list<U>::repeat(std::move(result[0]))
+                                 : zip_list<U>(std::move(result));
+        }
+
+        // Multiply then add, rounded once when the target has the instruction.
+        struct fused_multiply_add {
+            template <typename T>
+            T operator()(T a, T b, T c) const {
+                return a * b + c;
+            }
+
+#ifdef __FMA__
+            float operator()(float a, float b, float c) const { return std::fma(a, b, c); }
+            double operator()(double a, double b, double c) const { return std::fma(a, b, c); }
+#endif
+        };
+    };
+
+    // Specialize `Rebind` for `zip_list`.
+    template <typename T>
+    struct parametric_type_traits<zip_list<T>> {
+        using value_type = T;
+
+        template <typename U>
+        using rebind = zip_list<U>;
+    };
+
+    /**
+     * Combine lists elementwise: `fn(xs[i], ys[i], ...)`.
+     * In Haskell:
+     *      zipWith3 :: (a -> b -> c -> d) -> [a] -> [b] -> [c] -> [d]
+     */
+    template <typename Fn, typename... Ts, typename U = ResultOf<Fn(const Ts &...)>>
+    zip_list<U> zip_with(Fn &&fn, const zip_list<Ts> &... zs) {
+        ALGEBRA_INSTRUMENT_SCOPE(ap);
+        return _inner_impl::zip_with<U>(_inner_impl::zip_contiguous_ok<U, Ts...>{}, fn, zs...);
+    }
+
+    /**
+     * zip_list as functor, the vector of elements is mapped.
+     */
+    template <typename T>
+    struct functor<zip_list<T>> {
+        template <typename Fn, typename U = ResultOf<Fn(T)>>
+        static zip_list<U> fmap(Fn &&fn, const zip_list<T> &f) {
+            return rewrap(functor<std::vector<T>>::fmap(std::forward<Fn>(fn), f.get()), f);
+        }
+
+        template <typename Fn, typename U = ResultOf<Fn(T)>>
+        static zip_list<U> fmap(Fn &&fn, zip_list<T> &&f) {
+            bool infinite = f.infinite();
+            auto xs = functor<std::vector<T>>::fmap(std::forward<Fn>(fn), std::move(f).get());
+            return infinite ? zip_list<U>::repeat(std::move(xs[0])) : zip_list<U>(std::move(xs));
+        }
+
+        static constexpr bool instance = true;
+
+       private:
+        template <typename U>
+        static zip_list<U> rewrap(std::vector<U> &&xs, const zip_list<T> &f) {
+            return f.infinite() ? zip_list<U>::repeat(std::move(xs[0]))
+                                : zip_list<U>(std::move(xs));
+        }
+    };
+
+    /**
+     * zip_list as applicative, `pure` repeats the value and `ap` applies the
+     * functions elementwise.
+     */
+    template <typename T>
+    struct applicative<zip_list<T>, void> {
+        template <typename U>
+        using _F = zip_list<U>;
+
+        static _F<T> pure(T x) { return _F<T>::repeat(std::move(x)); }
+
+        template <typename Ff, typename Fn = ValueType<PlainType<Ff>>, typename U = ResultOf<Fn(T)>>
+        static _F<U> ap(Ff &&fn, const _F<T> &f) {
+            return zip_with([](const Fn &g, const T &x) { return g(x); }, fn, f);
+        }
+
+        template <typename Fn, typename U = ResultOf<Fn(T)>>
+        static _F<U> liftA(Fn &&fn, const _F<T> &f) {
+            return functor<_F<T>>::fmap(std::forward<Fn>(fn), f);
+        }
+
+        // In Haskell:
+        //      liftA2 :: applicative f => (a -> b -> c) -> f a -> f b -> f c
+        template <typename Fn, typename B, typename U = ResultOf<Fn(const T &, const B &)>>
+        static _F<U> liftA2(Fn &&fn, const _F<T> &f, const _F<B> &g) {
+            return zip_with(std::forward<Fn>(fn), f, g);
+        }
+
+        static constexpr bool instance = true;
+    };
+
+    template <typename Fn, typename A, typename B>
+    auto liftA2(Fn &&fn, const zip_list<A> &f, const zip_list<B> &g)
+            -> decltype(applicative<zip_list<A>>::liftA2(std::forward<Fn>(fn), f, g)) {
+        return applicative<zip_list<A>>::liftA2(std::forward<Fn>(fn), f, g);
+    }
+
+    /**
+     * zip_list as foldable, over the stored elements.
+     */
+    template <typename T>
+    struct foldable<zip_list<T>> : default_foldable<zip_list<T>> {};
+
+    /**
+     * Elementwise arithmetic.
+     */
+
+    template <typename T, typename = Requires<std::is_arithmetic<T>::value>>
+    zip_list<T> operator+(const zip_list<T> &a, const zip_list<T> &b) {
+        return zip_with(std::plus<T>(), a, b);
+    }
+
+    template <typename T, typename = Requires<std::is_arithmetic<T>::value>>
+    zip_list<T> operator-(const zip_list<T> &a, const zip_list<T> &b) {
+        return zip_with(std::minus<T>(), a, b);
+    }
+
+    template <typename T, typename = Requires<std::is_arithmetic<T>::value>>
+    zip_list<T> operator*(const zip_list<T> &a, const zip_list<T> &b) {
+        return zip_with(std::multiplies<T>(), a, b);
+    }
+
+    template <typename T, typename = Requires<std::is_arithmetic<T>::value>>
+    zip_list<T> operator/(const zip_list<T> &a, const zip_list<T> &b) {
+        return zip_with(std::divides<T>(), a, b);
+    }
+
+    // a * b + c.
+    template <typename T, typename = Requires<std::is_arithmetic<T>::value>>
+    zip_list<T> fma(const zip_list<T> &a, const zip_list<T> &b, const zip_list<T> &c) {
+        return zip_with(_inner_impl::fused_multiply_add{}, a, b, c);
+    }
+};
+
+#endif /* __ALGEBRA_DATA_ZIP_LIST_HPP__ */
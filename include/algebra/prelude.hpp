@@ -5,7 +5,15 @@
 #ifndef __ALGEBRA_PRELUDE_HPP__
 #define __ALGEBRA_PRELUDE_HPP__
 
+#include <atomic>
+#include <cstddef>
 #include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
 #include "./basic/type_concepts.hpp"
 #include "./basic/type_operation.hpp"
 
@@ -25,6 +33,13 @@ namespace algebra {
         }
     } _id{};
 
+    /**
+     * Unit type, the value of effects without a result.
+     * In haskell:
+     *      ()
+     */
+    using unit = std::tuple<>;
+
     /**
      * Constant function.
      * In haskell:
@@ -37,6 +52,185 @@ namespace algebra {
             return std::forward<T>(t);
         }
     } _const{};
+
+    /**
+     * Memoization of an unary pure function.
+     *
+     * The results are cached in a hash table split into shards, each guarded by
+     * its own mutex. The function is evaluated outside of the lock, and callers
+     * that ask for a key under evaluation wait for that result, so every
+     * distinct key is evaluated once even when called from many threads. With a
+     * non-zero capacity every shard keeps only its most recently used entries,
+     * the capacity is split between the shards, and there are no more shards
+     * than entries: at most `capacity` entries are cached, but the least
+     * recently used entry of a shard may be evicted before the cache is full.
+     *
+     * Copies share the same cache, so the memoized function can be passed by
+     * value to `%` and `>>=`.
+     */
+    template <typename K, typename V, typename Fn, typename Hash = std::hash<K>>
+    class memoized {
+        struct slot {
+            std::shared_future<V> value;
+            typename std::list<K>::iterator pos;
+            std::size_t ticket;
+        };
+
+        struct shard {
+            std::mutex lock;
+            std::list<K> order;  // most recently used first, only when bounded.
+            std::unordered_map<K, slot, Hash> cache;
+            std::size_t capacity = 0;  // 0 means unbounded.
+            std::size_t tickets = 0;
+        };
+
+        struct state {
+            Fn fn;
+            std::size_t capacity;  // in all, 0 means unbounded.
+            std::size_t count;
+            std::unique_ptr<shard[]> shards;
+            std::atomic<std::size_t> hits{0}, misses{0};
+
+            state(Fn f, std::size_t cap, std::size_t n)
+                    : fn(std::move(f)),
+                      capacity(cap),
+                      count(cap != 0 && cap < n ? cap : n),
+                      shards(new shard[count]) {
+                for (std::size_t i = 0; cap != 0 && i < count; ++i) {
+                    shards[i].capacity = cap / count + (i < cap % count ? 1 : 0);
+                }
+            }
+        };
+
+        std::shared_ptr<state> s_;
+
+        shard &shard_of(const K &k) const { return s_->shards[Hash{}(k) % s_->count]; }
+
+        // Look up `k`, the recency is refreshed on a hit. Called with the lock held.
+        bool lookup(shard &sh, const K &k, std::shared_future<V> &value) const {
+            auto it = sh.cache.find(k);
+            if (it == sh.cache.end()) {
+                return false;
+            }
+            if (s_->capacity) {
+                sh.order.splice(sh.order.begin(), sh.order, it->second.pos);
+            }
+            ++s_->hits;
+            value = it->second.value;
+            return true;
+        }
+
+        V evaluate(shard &sh, const K &k) const {
+            std::promise<V> p;
+            std::shared_future<V> value;
+            std::size_t ticket;
+            {
+                std::lock_guard<std::mutex> guard(sh.lock);
+                if (lookup(sh, k, value)) {
+                    return value.get();
+                }
+                value = p.get_future().share();
+                ticket = ++sh.tickets;
+                auto pos = sh.order.end();
+                if (s_->capacity) {
+                    pos = sh.order.insert(sh.order.begin(), k);
+                }
+                sh.cache.emplace(k, slot{value, pos, ticket});
+                if (s_->capacity && sh.cache.size() > sh.capacity) {
+                    sh.cache.erase(sh.order.back());
+                    sh.order.pop_back();
+                }
+                ++s_->misses;
+            }
+            try {
+                p.set_value(s_->fn(k));
+            } catch (...) {
+                // Forget the failed entry, a later call evaluates again.
+                {
+                    std::lock_guard<std::mutex> guard(sh.lock);
+                    auto it = sh.cache.find(k);
+                    if (it != sh.cache.end() && it->second.ticket == ticket) {
+                        if (s_->capacity) {
+                            sh.order.erase(it->second.pos);
+                        }
+                        sh.cache.erase(it);
+                    }
+                }
+                p.set_exception(std::current_exception());
+            }
+            return value.get();
+        }
+
+       public:
+        memoized(Fn fn, std::size_t capacity = 0, std::size_t shards = 16)
+                : s_(std::make_shared<state>(std::move(fn), capacity, shards == 0 ? 1 : shards)) {}
+
+        V operator()(const K &k) const {
+            shard &sh = shard_of(k);
+            std::shared_future<V> value;
+            {
+                std::lock_guard<std::mutex> guard(sh.lock);
+                lookup(sh, k, value);
+            }
+            return value.valid() ? value.get() : evaluate(sh, k);
+        }
+
+        // Number of calls answered from the cache.
+        std::size_t hits() const noexcept { return s_->hits.load(); }
+
+        // Number of calls that evaluated the function.
+        std::size_t misses() const noexcept { return s_->misses.load(); }
+
+        // Number of cached entries.
+        std::size_t size() const {
+            std::size_t n = 0;
+            for (std::size_t i = 0; i < s_->count; ++i) {
+                std::lock_guard<std::mutex> guard(s_->shards[i].lock);
+                n += s_->shards[i].cache.size();
+            }
+            return n;
+        }
+
+        void clear() {
+            for (std::size_t i = 0; i < s_->count; ++i) {
+                std::lock_guard<std::mutex> guard(s_->shards[i].lock);
+                s_->shards[i].cache.clear();
+                s_->shards[i].order.clear();
+            }
+            s_->hits = 0;
+            s_->misses = 0;
+        }
+    };
+
+    namespace _inner_impl {
+        // Use the explicit key type if given, otherwise the argument type of `Fn`.
+        template <typename K, typename Fn>
+        struct memo_key {
+            using type = K;
+        };
+
+        template <typename Fn>
+        struct memo_key<void, Fn> {
+            using type = ArgumentOf<Fn>;
+        };
+    };
+
+    /**
+     * Memoize an unary function. The key type is deduced from the argument of
+     * `fn`, or given explicitly (e.g., for generic lambdas) as `memoize<K>(fn)`.
+     *
+     * e.g.:
+     *      auto f = memoize([](int x) { return expensive(x); });
+     *      auto r = f % xs;
+     *      // f.hits(), f.misses()
+     */
+    template <typename K = void, typename Fn,
+              typename Key = typename _inner_impl::memo_key<K, Fn>::type,
+              typename V = ResultOf<Fn(const Key &)>>
+    memoized<Key, V, PlainType<Fn>> memoize(Fn &&fn, std::size_t capacity = 0,
+                                             std::size_t shards = 16) {
+        return memoized<Key, V, PlainType<Fn>>(std::forward<Fn>(fn), capacity, shards);
+    }
 };
 
 #endif /* __ALGEBRA_PRELUDE_HPP__ */
@@ -0,0 +1,126 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Unit test for alternative and monad_plus.
+ */
+
+#ifndef ALGEBRA_INSTRUMENT
+#define ALGEBRA_INSTRUMENT
+#endif
+
+#include <bandit/bandit.h>
+#include <algebra/control/alternative.hpp>
+#include <algebra/data/stl_container.hpp>
+#include <deque>
+#include <list>
+#include <memory>
+#include <vector>
+
+using namespace algebra;
+
+template <typename T>
+using counted_vector = std::vector<T, instrument::counting_allocator<T>>;
+
+go_bandit([]() {
+    bandit::describe("alternative test: ", [&]() {
+        auto even = [](int x) { return x % 2 == 0; };
+
+        bandit::it("mzero and mplus are the empty list and the concatenation", [&]() {
+            static_assert(Alternative<std::vector<int>>::value, "vector is an alternative");
+            static_assert(MonadPlus<std::list<int>>::value, "list is a monad_plus");
+            static_assert(!MonadPlus<int>::value, "int is not a monad_plus");
+            AssertThat(mzero<std::vector<int>>().empty(), IsTrue());
+            auto xs = mplus(std::vector<int>{1, 2}, std::vector<int>{3});
+            AssertThat(xs, Equals(std::vector<int>{1, 2, 3}));
+            auto ds = mplus(mzero<std::deque<int>>(), std::deque<int>{4});
+            AssertThat(ds, Equals(std::deque<int>{4}));
+        });
+
+        bandit::it("guard gives the unit or the failure", [&]() {
+            AssertThat(guard<std::vector<unit>>(true).size(), Equals(1u));
+            AssertThat(guard<std::vector<unit>>(false).size(), Equals(0u));
+            auto r = std::vector<int>{1, 2, 3} >>= [](int x) {
+                return guard<std::vector<unit>>(x != 2) >>= [x](unit) {
+                    return std::vector<int>{x};
+                };
+            };
+            AssertThat(r, Equals(std::vector<int>{1, 3}));
+        });
+
+        bandit::it("guard prunes the branches of a search", [&]() {
+            std::vector<int> range{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13};
+            auto triples = range >>= [&](int a) {
+                return range >>= [&, a](int b) {
+                    return range >>= [a, b](int c) {
+                        return guard(a < b && a * a + b * b == c * c, std::vector<int>{a, b, c});
+                    };
+                };
+            };
+            AssertThat(triples, Equals(std::vector<int>{3, 4, 5, 5, 12, 13, 6, 8, 10}));
+        });
+
+        bandit::it("a failed guard on an rvalue keeps its storage", [&]() {
+            counted_vector<int> xs{1, 2, 3};
+            const int *data = xs.data();
+            instrument::reset();
+            auto ys = guard(false, std::move(xs));
+            AssertThat(instrument::take().total().allocations, Equals(0u));
+            AssertThat(ys.empty(), IsTrue());
+            AssertThat(ys.data(), Equals(data));
+        });
+
+        bandit::it("mfilter compacts rvalues in place", [&]() {
+            counted_vector<int> xs{1, 2, 3, 4, 5, 6};
+            const int *data = xs.data();
+            instrument::reset();
+            auto ys = mfilter(even, std::move(xs));
+            AssertThat(instrument::take().total().allocations, Equals(0u));
+            AssertThat(ys.data(), Equals(data));
+            bool kept = ys == counted_vector<int>{2, 4, 6};
+            AssertThat(kept, IsTrue());
+
+            std::list<std::unique_ptr<int>> ps;
+            for (int i = 0; i < 5; ++i) {
+                ps.emplace_back(new int(i));
+            }
+            const int *one = std::next(ps.begin())->get();
+            auto odd = mfilter([](const std::unique_ptr<int> &p) { return *p % 2 == 1; },
+                               std::move(ps));
+            AssertThat(odd.size(), Equals(2u));
+            AssertThat(odd.front().get(), Equals(one));
+        });
+
+        bandit::it("mfilter copies lvalues", [&]() {
+            const std::vector<int> xs{1, 2, 3, 4};
+            AssertThat(mfilter(even, xs), Equals(std::vector<int>{2, 4}));
+            AssertThat(xs.size(), Equals(4u));
+            const std::deque<int> ds{1, 2, 3, 4};
+            AssertThat(mfilter(even, ds), Equals(std::deque<int>{2, 4}));
+        });
+
+        bandit::it("bind skips pruned branches without allocating", [&]() {
+            counted_vector<int> xs(100);
+            for (int i = 0; i < 100; ++i) {
+                xs[std::size_t(i)] = i;
+            }
+            instrument::reset();
+            auto none = xs >>= [](int x) { return guard(x < 0, counted_vector<int>{}); };
+            // Only the container of the results of the callback is allocated.
+            AssertThat(instrument::take().total().allocations, Equals(1u));
+            AssertThat(none.empty(), IsTrue());
+
+            instrument::reset();
+            auto one = xs >>= [](int x) {
+                return x == 42 ? counted_vector<int>{x, x} : mzero<counted_vector<int>>();
+            };
+            // And the result that wasn't pruned, which is moved as the result.
+            AssertThat(instrument::take().total().allocations, Equals(2u));
+            bool found = one == counted_vector<int>{42, 42};
+            AssertThat(found, IsTrue());
+        });
+    });
+});
+
+int main(int argc, char *argv[]) { return bandit::run(argc, argv); }
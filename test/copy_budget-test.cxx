@@ -0,0 +1,202 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Copy/move budgets of the container instances: the exact number of element
+ * copies, element moves and allocations of every combinator, so that a change
+ * making `fmap` or `bind` copy every element fails the tests.
+ */
+
+#ifndef ALGEBRA_INSTRUMENT
+#define ALGEBRA_INSTRUMENT
+#endif
+
+#include <bandit/bandit.h>
+#include <algebra/data/stl_container.hpp>
+#include <list>
+#include <string>
+#include <vector>
+
+using namespace algebra;
+using namespace algebra::instrument;
+
+using elem = counted<int>;
+using other = counted<long>;
+
+template <typename T>
+using vec = std::vector<T, counting_allocator<T>>;
+template <typename T>
+using lst = std::list<T, counting_allocator<T>>;
+using str = std::basic_string<char, std::char_traits<char>, counting_allocator<char>>;
+
+// The events of the combinator `c` while running `action`, the setup of the
+// arguments is done before and not accounted.
+template <typename Setup, typename Action>
+counters measure(combinator c, Setup setup, Action action) {
+    auto args = setup();
+    reset();
+    action(args);
+    return take()[c];
+}
+
+// The expected counts.
+struct budget {
+    std::size_t allocations, copies, moves;
+};
+
+#define AssertBudget(actual, expected)                               \
+    do {                                                             \
+        counters a = (actual);                                       \
+        budget b = expected;                                         \
+        AssertThat(a.calls, Equals(1u));                             \
+        AssertThat(a.allocations, Equals(b.allocations));            \
+        AssertThat(a.copies, Equals(b.copies));                      \
+        AssertThat(a.moves, Equals(b.moves));                        \
+    } while (0)
+
+const std::size_t n = 8;
+
+template <typename C>
+C make(std::size_t size = n) {
+    std::vector<int> xs(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        xs[i] = int(i);
+    }
+    return C(xs.begin(), xs.end());
+}
+
+// Containers of two elements, built without copying or moving elements.
+template <typename C>
+C pair_of(int x) {
+    C c;
+    algebra::_inner_impl::try_reserve(c, 2);
+    c.emplace_back(x);
+    c.emplace_back(x + 1);
+    return c;
+}
+
+template <template <typename> class C>
+void describe_budgets(const char *name, budget fmap_copy, budget fmap_move, budget fmap_other,
+                      budget bind, budget ap, budget mappend_copy, budget mappend_left,
+                      budget mappend_right, budget mappend_move, budget join_copy,
+                      budget join_move) {
+    using M = C<elem>;
+    auto inc = [](const elem &e) { return elem(e.value() + 1); };
+    auto widen = [](const elem &e) { return other(long(e.value())); };
+    auto pairs = [](const elem &e) { return pair_of<M>(e.value()); };
+
+    bandit::describe(name, [=]() {
+        bandit::it("fmap", [=]() {
+            AssertBudget(measure(combinator::fmap, [] { return make<M>(); },
+                                 [&](M &xs) { functor<M>::fmap(inc, xs); }),
+                         fmap_copy);
+            AssertBudget(measure(combinator::fmap, [] { return make<M>(); },
+                                 [&](M &xs) { functor<M>::fmap(inc, std::move(xs)); }),
+                         fmap_move);
+            AssertBudget(measure(combinator::fmap, [] { return make<M>(); },
+                                 [&](M &xs) { functor<M>::fmap(widen, std::move(xs)); }),
+                         fmap_other);
+        });
+
+        bandit::it("bind", [=]() {
+            AssertBudget(measure(combinator::bind, [] { return make<M>(); },
+                                 [&](M &xs) { monad<M>::bind(xs, pairs); }),
+                         bind);
+            AssertBudget(measure(combinator::bind, [] { return make<M>(); },
+                                 [&](M &xs) { monad<M>::bind(std::move(xs), pairs); }),
+                         bind);
+        });
+
+        bandit::it("ap", [=]() {
+            using Fn = elem (*)(const elem &);
+            auto setup = [] {
+                C<Fn> fs;
+                fs.push_back([](const elem &e) { return elem(e.value() + 1); });
+                fs.push_back([](const elem &e) { return elem(e.value() * 2); });
+                return std::make_pair(fs, make<M>());
+            };
+            AssertBudget(measure(combinator::ap, setup,
+                                 [](std::pair<C<Fn>, M> &a) {
+                                     monad<M>::ap(a.first, a.second);
+                                 }),
+                         ap);
+        });
+
+        bandit::it("mappend", [=]() {
+            auto two = [] { return std::make_pair(make<M>(), make<M>()); };
+            using P = std::pair<M, M>;
+            AssertBudget(measure(combinator::mappend, two,
+                                 [](P &p) { monoid<M>::mappend(p.first, p.second); }),
+                         mappend_copy);
+            AssertBudget(measure(combinator::mappend, two,
+                                 [](P &p) { monoid<M>::mappend(std::move(p.first), p.second); }),
+                         mappend_left);
+            AssertBudget(measure(combinator::mappend, two,
+                                 [](P &p) { monoid<M>::mappend(p.first, std::move(p.second)); }),
+                         mappend_right);
+            AssertBudget(measure(combinator::mappend, two,
+                                 [](P &p) {
+                                     monoid<M>::mappend(std::move(p.first), std::move(p.second));
+                                 }),
+                         mappend_move);
+        });
+
+        bandit::it("join", [=]() {
+            auto nested = [] {
+                C<M> mm;
+                for (std::size_t i = 0; i < n; ++i) {
+                    mm.push_back(pair_of<M>(int(i)));
+                }
+                return mm;
+            };
+            AssertBudget(measure(combinator::join, nested,
+                                 [](C<M> &mm) { monad<M>::join(mm); }),
+                         join_copy);
+            AssertBudget(measure(combinator::join, nested,
+                                 [](C<M> &mm) { monad<M>::join(std::move(mm)); }),
+                         join_move);
+        });
+    });
+}
+
+go_bandit([]() {
+    bandit::describe("Copy/move budget test: ", [&]() {
+        // Vectors are presized: one allocation per result, elements are moved
+        // into it (results of functions) or copied only from lvalue operands.
+        describe_budgets<vec>("std::vector", {1, 0, n}, {0, 0, n}, {1, 0, n},
+                              {n + 2, 0, 2 * n}, {1, 0, 2 * n}, {1, 2 * n, 0}, {1, n, n},
+                              {1, n, n}, {1, 0, 2 * n}, {1, 2 * n, 0}, {1, 0, 2 * n});
+
+        // Lists allocate a node per element, and are spliced when moved.
+        describe_budgets<lst>("std::list", {n, 0, n}, {0, 0, n}, {n, 0, n}, {3 * n, 0, 0},
+                              {2 * n, 0, 2 * n}, {2 * n, 2 * n, 0}, {n, n, 0}, {n, n, 0},
+                              {0, 0, 0}, {2 * n, 2 * n, 0}, {0, 0, 0});
+
+        bandit::describe("std::basic_string", [&]() {
+            // Longer than any small string buffer.
+            auto two = [] { return std::make_pair(str(100, 'a'), str(100, 'b')); };
+            using P = std::pair<str, str>;
+
+            bandit::it("mappend allocates once", [&]() {
+                auto copy = measure(combinator::mappend, two,
+                                    [](P &p) { monoid<str>::mappend(p.first, p.second); });
+                auto left = measure(combinator::mappend, two, [](P &p) {
+                    monoid<str>::mappend(std::move(p.first), p.second);
+                });
+                auto right = measure(combinator::mappend, two, [](P &p) {
+                    monoid<str>::mappend(p.first, std::move(p.second));
+                });
+                auto both = measure(combinator::mappend, two, [](P &p) {
+                    monoid<str>::mappend(std::move(p.first), std::move(p.second));
+                });
+                AssertThat(copy.allocations, Equals(1u));
+                AssertThat(left.allocations, Equals(1u));
+                AssertThat(right.allocations, Equals(1u));
+                AssertThat(both.allocations, Equals(1u));
+            });
+        });
+    });
+});
+
+int main(int argc, char *argv[]) { return bandit::run(argc, argv); }
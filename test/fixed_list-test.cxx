@@ -0,0 +1,118 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Unit test for compile time evaluation of fmap, bind and folds over
+ * `std::array` and `fixed_list`.
+ */
+
+#include <bandit/bandit.h>
+#include <algebra/data/fixed_list.hpp>
+#include <algebra/data/stl_container.hpp>
+#include <array>
+
+using namespace algebra;
+
+struct square {
+    constexpr int operator()(int x) const { return x * x; }
+};
+
+struct add {
+    constexpr int operator()(int a, int b) const { return a + b; }
+};
+
+struct sub {
+    constexpr int operator()(int a, int b) const { return a - b; }
+};
+
+struct to_sum {
+    constexpr sum_monoid<int> operator()(int x) const { return sum(x); }
+};
+
+struct plus_minus {
+    constexpr fixed_list<int, 2> operator()(int x) const { return fixed_list<int, 2>{x, -x}; }
+};
+
+struct odd_only {
+    constexpr fixed_list<int, 1> operator()(int x) const {
+        return x % 2 ? fixed_list<int, 1>{x} : fixed_list<int, 1>{};
+    }
+};
+
+constexpr int twice(int x) { return 2 * x; }
+
+using A4 = std::array<int, 4>;
+using L4 = fixed_list<int, 4>;
+
+constexpr A4 xs{{1, 2, 3, 4}};
+constexpr A4 squares = functor<A4>::fmap(square{}, xs);
+constexpr A4 twices = applicative<A4>::ap(std::array<int (*)(int), 4>{{twice, twice, twice, twice}},
+                                          xs);
+
+static_assert(std::get<3>(squares) == 16, "fmap over std::array");
+static_assert(std::get<2>(twices) == 6, "ap over std::array");
+static_assert(foldl(sub{}, 0, xs) == -10, "foldl over std::array");
+static_assert(foldr(sub{}, 0, xs) == -2, "foldr over std::array");
+static_assert(int(foldMap(to_sum{}, squares)) == 30, "foldMap over std::array");
+
+constexpr L4 ys{1, 2, 3};
+constexpr auto pm = monad<L4>::bind(ys, plus_minus{});
+constexpr auto odds = monad<L4>::bind(ys, odd_only{});
+
+static_assert(decltype(pm)::capacity() == 8, "bind multiplies the capacity");
+static_assert(pm == fixed_list<int, 6>{1, -1, 2, -2, 3, -3}, "bind over fixed_list");
+static_assert(odds.size() == 2 && odds[1] == 3, "bind may give fewer elements");
+static_assert(foldl(add{}, 0, pm) == 0, "foldl over fixed_list");
+static_assert(int(foldMap(to_sum{}, functor<L4>::fmap(square{}, ys))) == 14,
+              "foldMap over fixed_list");
+static_assert(fixed_list<int, 3>(xs.size() == 4 ? std::array<int, 2>{{7, 8}}
+                                                : std::array<int, 2>{{0, 0}})[1] == 8,
+              "fixed_list from std::array");
+
+#if __cplusplus >= 201703L
+// Lambdas are `constexpr` since C++17.
+static_assert(std::get<0>(functor<A4>::fmap([](int x) { return x + 10; }, xs)) == 11,
+              "constexpr lambda");
+#endif
+
+go_bandit([]() {
+    bandit::describe("fixed_list test: ", [&]() {
+        bandit::it("constexpr results are usable at runtime", [&]() {
+            AssertThat(squares, Equals(A4{{1, 4, 9, 16}}));
+            AssertThat(pm.size(), Equals(6u));
+        });
+
+        bandit::it("join and then", [&]() {
+            fixed_list<fixed_list<int, 2>, 3> nested{fixed_list<int, 2>{1, 2},
+                                                    fixed_list<int, 2>{3}};
+            auto flat = monad<fixed_list<int, 2>>::join(nested);
+            bool flattened = flat == fixed_list<int, 3>{1, 2, 3};
+            AssertThat(flattened, IsTrue());
+            auto r = monad<L4>::then(ys, fixed_list<char, 1>{'a'});
+            bool repeated = r == fixed_list<char, 3>{'a', 'a', 'a'};
+            AssertThat(repeated, IsTrue());
+        });
+
+        bandit::it("the operators work at runtime", [&]() {
+            auto r = ys >>= [](int x) { return fixed_list<int, 2>{x, x}; };
+            AssertThat(r.size(), Equals(6u));
+            auto s = [](int x) { return x + 1; } % ys;
+            bool mapped = s == L4{2, 3, 4};
+            AssertThat(mapped, IsTrue());
+        });
+
+        bandit::it("exceeding the capacity throws", [&]() {
+            fixed_list<int, 1> l{1};
+            bool thrown = false;
+            try {
+                l.push_back(2);
+            } catch (const std::length_error &) {
+                thrown = true;
+            }
+            AssertThat(thrown, IsTrue());
+        });
+    });
+});
+
+int main(int argc, char *argv[]) { return bandit::run(argc, argv); }
@@ -0,0 +1,101 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Unit test for inplace_function and function_ref.
+ */
+
+#include <bandit/bandit.h>
+#include <algebra/data/function.hpp>
+#include <algebra/data/stl_container.hpp>
+#include <list>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+static int twice(int x) { return 2 * x; }
+
+// Counts its copies.
+struct counted {
+    static int copies;
+    int k;
+
+    explicit counted(int k) : k(k) {}
+    counted(const counted &other) : k(other.k) { ++copies; }
+    counted(counted &&other) noexcept : k(other.k) {}
+    int operator()(int x) const { return x + k; }
+};
+
+int counted::copies = 0;
+
+static_assert(std::is_nothrow_move_constructible<algebra::inplace_function<int(int)>>::value,
+              "nothrow move");
+static_assert(std::is_nothrow_move_assignable<algebra::inplace_function<int(int)>>::value,
+              "nothrow move");
+
+go_bandit([]() {
+    bandit::describe("Function test: ", [&]() {
+        bandit::it("inplace_function copies and moves its callable", [&]() {
+            auto p = std::make_shared<int>(5);
+            algebra::inplace_function<int(int)> f = [p](int x) { return x + *p; };
+            auto g = f;
+            AssertThat(g(1), Equals(6));
+            auto h = std::move(f);
+            AssertThat(h(2), Equals(7));
+            AssertThat(bool(f), IsFalse());
+            AssertThat(p.use_count(), Equals(3));
+        });
+
+        bandit::it("inplace_function moves when a std::vector grows", [&]() {
+            std::vector<algebra::inplace_function<int(int)>> fs;
+            for (int i = 0; i < 100; ++i) {
+                fs.emplace_back(counted(i));
+            }
+            AssertThat(counted::copies, Equals(0));
+            AssertThat(fs[99](1), Equals(100));
+
+            fs[0] = std::move(fs[99]);
+            AssertThat(fs[0](1), Equals(100));
+            AssertThat(bool(fs[99]), IsFalse());
+            fs[1] = fs[2];
+            AssertThat(counted::copies, Equals(1));
+            AssertThat(fs[1](1), Equals(3));
+        });
+
+        bandit::it("function_ref refers to lambdas and functions", [&]() {
+            auto f = [](int x) { return x * 3; };
+            algebra::function_ref<int(int)> r1 = f, r2 = twice;
+            AssertThat(r1(2), Equals(6));
+            AssertThat(r2(2), Equals(4));
+        });
+
+        bandit::it("applicative::ap on list of inplace_function", [&]() {
+            using algebra::operator*;
+            std::list<algebra::inplace_function<int(int)>> fs{[](int x) { return x - 1; },
+                                                              [](int x) { return x + 1; }};
+            auto r = fs * std::list<int>{1, 2};
+            AssertThat(r, Equals(std::list<int>{0, 1, 2, 3}));
+        });
+
+        bandit::it("applicative::ap on vector of function_ref", [&]() {
+            using algebra::operator*;
+            auto triple = [](int x) { return x * 3; };
+            std::vector<algebra::function_ref<int(int)>> fs{twice, triple};
+            auto r = fs * std::vector<int>{1, 2};
+            AssertThat(r, Equals(std::vector<int>{2, 4, 3, 6}));
+            auto s = algebra::applicative<std::vector<int>>::ap(fs, std::vector<int>{5});
+            AssertThat(s, Equals(std::vector<int>{10, 15}));
+        });
+
+        bandit::it("applicative::ap on vector of one closure type", [&]() {
+            using algebra::operator*;
+            auto inc = [](int x) { return x + 1; };
+            std::vector<decltype(inc)> fs{inc, inc};
+            auto r = fs * std::vector<int>{1, 2};
+            AssertThat(r, Equals(std::vector<int>{2, 3, 2, 3}));
+        });
+    });
+});
+
+int main(int argc, char *argv[]) { return bandit::run(argc, argv); }
@@ -0,0 +1,138 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Unit test for lazy infinite generators.
+ */
+
+#include <bandit/bandit.h>
+#include <algebra/control/generator.hpp>
+#include <algebra/data/array_view.hpp>
+#include <cstdlib>
+#include <list>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace algebra;
+
+// Count the allocations of the whole program, to check that generators don't
+// allocate.
+static std::size_t allocations = 0;
+
+void *operator new(std::size_t n) {
+    ++allocations;
+    if (void *p = std::malloc(n == 0 ? 1 : n)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+template <typename G>
+static std::vector<typename G::value_type> collect(generator<G> g) {
+    return std::vector<typename G::value_type>(g.begin(), g.end());
+}
+
+go_bandit([]() {
+    bandit::describe("generator test: ", [&]() {
+        bandit::it("iota and take", [&]() {
+            AssertThat(collect(take(4, iota(1))), Equals(std::vector<int>{1, 2, 3, 4}));
+            AssertThat(collect(take(3, iota(0.5, 0.25))),
+                       Equals(std::vector<double>{0.5, 0.75, 1.0}));
+            AssertThat(collect(take(0, iota(1))), IsEmpty());
+        });
+
+        bandit::it("repeat, cycle and iterate", [&]() {
+            AssertThat(collect(take(3, repeat(std::string("a")))),
+                       Equals(std::vector<std::string>{"a", "a", "a"}));
+            AssertThat(collect(take(5, cycle(std::vector<int>{1, 2}))),
+                       Equals(std::vector<int>{1, 2, 1, 2, 1}));
+            AssertThat(collect(take(5, cycle(std::vector<int>{}))), IsEmpty());
+            auto letters = cycle(std::list<char>{'a', 'b', 'c'});
+            char c = 0;
+            letters.next(c), letters.next(c);
+            auto copy = letters;
+            AssertThat(collect(take(4, std::move(letters))),
+                       Equals(std::vector<char>{'c', 'a', 'b', 'c'}));
+            AssertThat(collect(take(2, copy)), Equals(std::vector<char>{'c', 'a'}));
+            auto twice = [](int x) { return 2 * x; };
+            AssertThat(collect(take(5, iterate(twice, 1))),
+                       Equals(std::vector<int>{1, 2, 4, 8, 16}));
+        });
+
+        bandit::it("unfold until the function gives false", [&]() {
+            // The Fibonacci numbers below 50.
+            auto fib = unfold<int>(std::make_pair(0, 1), [](std::pair<int, int> &s, int &out) {
+                if (s.first >= 50) {
+                    return false;
+                }
+                out = s.first;
+                s = std::make_pair(s.second, s.first + s.second);
+                return true;
+            });
+            AssertThat(collect(fib), Equals(std::vector<int>{0, 1, 1, 2, 3, 5, 8, 13, 21, 34}));
+        });
+
+        bandit::it("takeWhile and find short-circuit infinite generators", [&]() {
+            auto squares = [](int x) { return x * x; } % iota(1);
+            AssertThat(collect(takeWhile([](int x) { return x < 30; }, squares)),
+                       Equals(std::vector<int>{1, 4, 9, 16, 25}));
+            int first = 0;
+            AssertThat(find([](int x) { return x > 1000; }, squares, first), IsTrue());
+            AssertThat(first, Equals(1024));
+            AssertThat(find([](int x) { return x > 10; }, take(3, squares), first), IsFalse());
+        });
+
+        bandit::it("fmap composes into the generator", [&]() {
+            auto g = [](int x) { return x + 1; } % ([](int x) { return x * 10; } % iota(0));
+            auto s = [](int x) { return std::to_string(x); } % take(3, g);
+            AssertThat(collect(s), Equals(std::vector<std::string>{"1", "11", "21"}));
+            // Mapping twice composes the functions, the state has one source.
+            using source = decltype(iota(0))::state_type;
+            bool fused = std::is_same<decltype(g.state().g), source>::value;
+            AssertThat(fused, IsTrue());
+        });
+
+        bandit::it("copies are independent", [&]() {
+            auto g = iota(1);
+            int x = 0;
+            g.next(x);
+            auto h = g;
+            g.next(x);
+            AssertThat(x, Equals(2));
+            h.next(x);
+            AssertThat(x, Equals(2));
+        });
+
+        bandit::it("foldable over finite generators", [&]() {
+            auto g = take(10, iota(1));
+            AssertThat(foldl([](int a, int b) { return a + b; }, 0, g), Equals(55));
+            AssertThat(int(foldMap([](int x) { return sum(x); }, g)), Equals(55));
+        });
+
+        bandit::it("doesn't allocate", [&]() {
+            int data[] = {3, 1, 2};
+            std::size_t before = allocations;
+            auto g = [](int x) { return x * x; } % takeWhile([](int x) { return x < 100; },
+                                                              iterate([](int x) { return x + 7; },
+                                                                      1));
+            auto h = take(7, cycle(array_view<int>(data)));
+            int total = foldl([](int a, int b) { return a + b; }, 0, g) +
+                        foldl([](int a, int b) { return a + b; }, 0, h);
+            AssertThat(allocations - before, Equals(0u));
+            int expected = 3 + 1 + 2 + 3 + 1 + 2 + 3;
+            for (int x = 1; x < 100; x += 7) {
+                expected += x * x;
+            }
+            AssertThat(total, Equals(expected));
+        });
+    });
+});
+
+int main(int argc, char *argv[]) { return bandit::run(argc, argv); }
@@ -0,0 +1,71 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Unit test for the instrumentation of container instances.
+ */
+
+#ifndef ALGEBRA_INSTRUMENT
+#define ALGEBRA_INSTRUMENT
+#endif
+
+#include <bandit/bandit.h>
+#include <algebra/data/stl_container.hpp>
+#include <vector>
+
+using namespace algebra;
+
+using elem = instrument::counted<int>;
+using vec = std::vector<elem, instrument::counting_allocator<elem>>;
+
+go_bandit([]() {
+    bandit::describe("Instrument test: ", [&]() {
+        vec xs{elem(1), elem(2), elem(3)};
+        auto inc = [](const elem &e) { return elem(e.value() + 1); };
+
+        bandit::it("counted records copies and moves", [&]() {
+            instrument::reset();
+            elem a(1);
+            elem b = a;
+            elem c = std::move(a);
+            c = b;
+            auto s = instrument::take();
+            AssertThat(s[instrument::combinator::none].copies, Equals(2u));
+            AssertThat(s[instrument::combinator::none].moves, Equals(1u));
+        });
+
+        bandit::it("events are accounted to the combinator", [&]() {
+            instrument::reset();
+            auto ys = functor<vec>::fmap(inc, xs);
+            auto s = instrument::take();
+            AssertThat(s[instrument::combinator::fmap].calls, Equals(1u));
+            AssertThat(s[instrument::combinator::fmap].copies, Equals(0u));
+            AssertThat(s[instrument::combinator::fmap].allocations > 0, Equals(true));
+            AssertThat(s[instrument::combinator::mappend].calls, Equals(0u));
+        });
+
+        bandit::it("nested combinators are accounted to the outer one", [&]() {
+            auto dup = [](const elem &e) { return vec{e, e}; };
+            auto nested = functor<vec>::fmap(dup, xs);
+            instrument::reset();
+            auto flat = monad<vec>::join(nested);
+            auto s = instrument::take();
+            AssertThat(flat.size(), Equals(6u));
+            AssertThat(s[instrument::combinator::join].calls, Equals(1u));
+            AssertThat(s[instrument::combinator::bind].calls, Equals(0u));
+            AssertThat(s[instrument::combinator::fmap].calls, Equals(0u));
+        });
+
+        bandit::it("reset and total", [&]() {
+            auto zs = monoid<vec>::mappend(xs, xs);
+            auto total = instrument::take().total();
+            AssertThat(total.copies >= 6, Equals(true));
+            AssertThat(total.bytes >= 6 * sizeof(elem), Equals(true));
+            instrument::reset();
+            AssertThat(instrument::take().total().calls, Equals(0u));
+        });
+    });
+});
+
+int main(int argc, char *argv[]) { return bandit::run(argc, argv); }
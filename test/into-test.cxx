@@ -0,0 +1,115 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Unit test for the combinators writing into caller-owned outputs.
+ */
+
+#ifndef ALGEBRA_INSTRUMENT
+#define ALGEBRA_INSTRUMENT
+#endif
+
+#include <bandit/bandit.h>
+#include <algebra/data/fixed_list.hpp>
+#include <algebra/data/into.hpp>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace algebra;
+
+template <typename T>
+using counted_vector = std::vector<T, instrument::counting_allocator<T>>;
+
+go_bandit([]() {
+    bandit::describe("into test: ", [&]() {
+        auto half = [](int x) { return float(x) / 2; };
+
+        bandit::it("fmap_into a container reuses its capacity", [&]() {
+            std::vector<int> xs{1, 2, 3, 4};
+            counted_vector<float> out;
+            fmap_into(half, xs, out);
+            AssertThat(out.size(), Equals(4u));
+            AssertThat(out[3], Equals(2.0f));
+            instrument::reset();
+            for (int i = 0; i < 100; ++i) {
+                int request[] = {i, i + 1, i + 2};
+                fmap_into(half, array_view<int>(request), out);
+            }
+            AssertThat(instrument::take().total().allocations, Equals(0u));
+            AssertThat(out.size(), Equals(3u));
+            AssertThat(out[2], Equals(50.5f));
+        });
+
+        bandit::it("fmap_into an output iterator or a view", [&]() {
+            std::list<int> xs{1, 2, 3};
+            std::ostringstream s;
+            fmap_into([](int x) { return x * x; }, xs, std::ostream_iterator<int>(s, " "));
+            AssertThat(s.str(), Equals("1 4 9 "));
+            float buffer[8];
+            auto written = fmap_into(half, make_range(xs.begin(), xs.end()),
+                                     array_view<float>(buffer));
+            AssertThat(written.size(), Equals(3u));
+            AssertThat(written[2], Equals(1.5f));
+            bool thrown = false;
+            try {
+                fmap_into(half, xs, array_view<float>(buffer, 2));
+            } catch (const std::length_error &) {
+                thrown = true;
+            }
+            AssertThat(thrown, IsTrue());
+        });
+
+        bandit::it("bind_into without intermediate containers", [&]() {
+            std::vector<int> xs{1, 2, 3};
+            counted_vector<int> out;
+            auto pm = [](int x) { return fixed_list<int, 2>{x, -x}; };
+            bind_into(xs, pm, out);
+            instrument::reset();
+            bind_into(xs, pm, out);
+            AssertThat(instrument::take().total().allocations, Equals(0u));
+            AssertThat(out, Equals(counted_vector<int>{1, -1, 2, -2, 3, -3}));
+            int buffer[4];
+            auto odd = [](int x) {
+                return x % 2 ? fixed_list<int, 1>{x} : fixed_list<int, 1>{};
+            };
+            auto written = bind_into(xs, odd, array_view<int>(buffer));
+            AssertThat(written.size(), Equals(2u));
+            AssertThat(written[1], Equals(3));
+        });
+
+        bandit::it("bind_into moves the elements of results returned by value", [&]() {
+            std::vector<int> xs{1, 2};
+            std::vector<std::unique_ptr<int>> out;
+            bind_into(xs,
+                      [](int x) {
+                          std::vector<std::unique_ptr<int>> r;
+                          r.emplace_back(new int(x));
+                          return r;
+                      },
+                      out);
+            AssertThat(out.size(), Equals(2u));
+            AssertThat(*out[1], Equals(2));
+        });
+
+        bandit::it("mappend_into", [&]() {
+            std::string a = "abc", b = "de";
+            std::string out;
+            mappend_into(a, b, out);
+            AssertThat(out, Equals("abcde"));
+            std::vector<char> chars;
+            mappend_into(make_range(a.begin(), a.end()), b, std::back_inserter(chars));
+            AssertThat(chars.size(), Equals(5u));
+            char buffer[5];
+            auto written = mappend_into(b, a, array_view<char>(buffer));
+            AssertThat(std::string(written.begin(), written.end()), Equals("deabc"));
+        });
+    });
+});
+
+int main(int argc, char *argv[]) { return bandit::run(argc, argv); }
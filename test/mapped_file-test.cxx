@@ -0,0 +1,164 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Unit test for memory-mapped files and array views.
+ */
+
+#include <bandit/bandit.h>
+#include <unistd.h>
+#include <algebra/data/mapped_file.hpp>
+#include <algebra/data/stl_container.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace algebra;
+
+// Whether some mapping of the process overlaps [begin, end), from /proc/self/maps.
+static bool is_mapped(std::uintptr_t begin, std::uintptr_t end) {
+    std::ifstream maps("/proc/self/maps");
+    std::string line;
+    while (std::getline(maps, line)) {
+        std::size_t dash = line.find('-');
+        auto low = std::stoull(line.substr(0, dash), nullptr, 16);
+        auto high = std::stoull(line.substr(dash + 1), nullptr, 16);
+        if (low < end && begin < high) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Write `values` to a fresh temporary file, return its path.
+static std::string write_records(const std::vector<std::int32_t> &values) {
+    char path[] = "/tmp/algebra-mapped_file-XXXXXX";
+    int fd = ::mkstemp(path);
+    std::size_t bytes = values.size() * sizeof(std::int32_t);
+    if (fd < 0 || ::write(fd, values.data(), bytes) != static_cast<ssize_t>(bytes)) {
+        throw std::runtime_error("can't write temporary file");
+    }
+    ::close(fd);
+    return path;
+}
+
+go_bandit([]() {
+    bandit::describe("Mapped file test: ", [&]() {
+        std::vector<std::int32_t> values;
+        for (std::int32_t i = 1; i <= 100000; ++i) {
+            values.push_back(i);
+        }
+        std::string path = write_records(values);
+
+        bandit::it("view the records of a file", [&]() {
+            mapped_file file(path);
+            auto v = file.view<std::int32_t>();
+            AssertThat(file.size(), Equals(values.size() * sizeof(std::int32_t)));
+            AssertThat(v.size(), Equals(values.size()));
+            AssertThat(v[0], Equals(1));
+            AssertThat(v[v.size() - 1], Equals(100000));
+        });
+
+        bandit::it("fold the records", [&]() {
+            mapped_file file(path, mapped_file::advice::sequential, true);
+            auto v = file.view<std::int32_t>();
+            auto f = [](std::int32_t x) { return sum<std::int64_t>(x); };
+            std::int64_t expected = 100000LL * 100001 / 2;
+            AssertThat(foldMap(f, v).value, Equals(expected));
+            AssertThat(parallel_foldMap(f, v, 4).value, Equals(expected));
+            AssertThat(parallel_foldMap(f, v.subview(0, 3), 4).value, Equals(6));
+            auto first = foldr([](std::int32_t x, std::int32_t) { return x; }, 0, v);
+            AssertThat(first, Equals(1));
+        });
+
+        bandit::it("unmap the whole aligned mapping of a file of partial pages", [&]() {
+            std::vector<std::int32_t> odd(values.begin(), values.begin() + 3 * 1024 + 31);
+            std::string odd_path = write_records(odd);
+            mapped_file file(odd_path, mapped_file::advice::normal, true);
+            auto v = file.view<std::int32_t>();
+            AssertThat(v.size(), Equals(odd.size()));
+            AssertThat(v[v.size() - 1], Equals(odd.back()));
+            auto begin = reinterpret_cast<std::uintptr_t>(file.data());
+            auto end = begin + (std::uintptr_t(2) << 20);
+            AssertThat(begin % (std::uintptr_t(2) << 20), Equals(0u));
+            AssertThat(is_mapped(begin, end), Equals(true));
+            AssertThat(file.unmap(), Equals(true));
+            AssertThat(file.unmap(), Equals(true));
+            AssertThat(is_mapped(begin, end), Equals(false));
+            AssertThat(std::remove(odd_path.c_str()), Equals(0));
+        });
+
+        bandit::it("parallel fold keeps the order", [&]() {
+            mapped_file file(path, mapped_file::advice::willneed);
+            auto v = file.view<std::int32_t>().subview(0, 20000);
+            auto f = [](std::int32_t x) { return std::vector<std::int32_t>{x}; };
+            auto all = parallel_foldMap(f, v, 3, 1000);
+            AssertThat(all.size(), Equals(20000u));
+            AssertThat(all == std::vector<std::int32_t>(values.begin(), values.begin() + 20000),
+                       Equals(true));
+        });
+
+        bandit::it("parallel fold throws the exceptions of any chunk", [&]() {
+            mapped_file file(path);
+            auto v = file.view<std::int32_t>().subview(0, 20000);
+            for (std::int32_t bad : {10, 19990}) {
+                auto f = [bad](std::int32_t x) {
+                    if (x == bad) {
+                        throw std::runtime_error("bad record");
+                    }
+                    return sum<std::int64_t>(x);
+                };
+                bool thrown = false;
+                try {
+                    parallel_foldMap(f, v, 4, 1000);
+                } catch (const std::runtime_error &) {
+                    thrown = true;
+                }
+                AssertThat(thrown, IsTrue());
+            }
+        });
+
+        bandit::it("fmap into a vector", [&]() {
+            using algebra::operator%;
+            mapped_file file(path);
+            auto v = file.view<std::int32_t>().subview(1, 3);
+            auto r = [](std::int32_t x) { return x * 0.5; } % v;
+            AssertThat(r, Equals(std::vector<double>{1.0, 1.5, 2.0}));
+        });
+
+        bandit::it("views of containers", [&]() {
+            std::vector<int> xs{1, 2, 3};
+            array_view<const int> v(xs);
+            auto r = [](int x) { return x + 1; } % v;
+            AssertThat(r, Equals(std::vector<int>{2, 3, 4}));
+            AssertThat(v.subview(5).empty(), Equals(true));
+        });
+
+        bandit::it("move the mapping", [&]() {
+            mapped_file a(path);
+            mapped_file b(std::move(a));
+            AssertThat(a.empty(), Equals(true));
+            AssertThat(b.view<std::int32_t>().size(), Equals(values.size()));
+        });
+
+        bandit::it("missing file", [&]() {
+            bool thrown = false;
+            try {
+                mapped_file file("/nonexistent/algebra-file");
+            } catch (const std::system_error &) {
+                thrown = true;
+            }
+            AssertThat(thrown, Equals(true));
+        });
+
+        bandit::it("remove the temporary file", [&]() {
+            AssertThat(std::remove(path.c_str()), Equals(0));
+        });
+    });
+});
+
+int main(int argc, char *argv[]) { return bandit::run(argc, argv); }
@@ -0,0 +1,157 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Unit test for matrices over semirings.
+ */
+
+#include <bandit/bandit.h>
+#include <algebra/data/matrix.hpp>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace algebra;
+
+// The product by the definition, to compare with the blocked kernel.
+template <typename S>
+matrix<S> naive_product(const matrix<S> &a, const matrix<S> &b) {
+    matrix<S> c(a.rows(), b.cols());
+    for (std::size_t i = 0; i < a.rows(); ++i) {
+        for (std::size_t j = 0; j < b.cols(); ++j) {
+            auto s = S::zero();
+            for (std::size_t k = 0; k < a.cols(); ++k) {
+                s = S::add(s, S::mul(a(i, k), b(k, j)));
+            }
+            c(i, j) = s;
+        }
+    }
+    return c;
+}
+
+template <typename S>
+matrix<S> sample(std::size_t rows, std::size_t cols, unsigned seed) {
+    matrix<S> m(rows, cols);
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) {
+            m(i, j) = typename S::value_type((i * 31 + j * 17 + seed) % 7);
+        }
+    }
+    return m;
+}
+
+// Integers where -1 is an invalid value, that throws when multiplied.
+struct checked_times : plus_times<long> {
+    static long mul(long a, long b) {
+        if (a == -1 || b == -1) {
+            throw std::domain_error("invalid value");
+        }
+        return a * b;
+    }
+};
+
+go_bandit([]() {
+    bandit::describe("matrix test: ", [&]() {
+        using real = plus_times<double>;
+
+        bandit::it("the product of matrices, with the identity of any size", [&]() {
+            matrix<real> a(2, 3, {1, 2, 3, 4, 5, 6}), b(3, 2, {7, 8, 9, 10, 11, 12});
+            AssertThat(a ^ b, Equals(matrix<real>(2, 2, {58, 64, 139, 154})));
+            AssertThat(a ^ monoid<matrix<real>>::mempty(), Equals(a));
+            AssertThat(matrix<real>() ^ b, Equals(b));
+            AssertThat(matrix<real>::identity(2) ^ a, Equals(a));
+            bool thrown = false;
+            try {
+                a ^ a;
+            } catch (const std::invalid_argument &) {
+                thrown = true;
+            }
+            AssertThat(thrown, IsTrue());
+        });
+
+        bandit::it("the blocked kernel matches the definition at every edge", [&]() {
+            auto a = sample<plus_times<int>>(37, 300, 1), b = sample<plus_times<int>>(300, 29, 2);
+            AssertThat(a ^ b, Equals(naive_product(a, b)));
+            auto c = sample<plus_times<float>>(70, 70, 3);
+            AssertThat(c ^ c, Equals(naive_product(c, c)));
+            auto d = sample<or_and>(65, 130, 4), e = sample<or_and>(130, 3, 5);
+            AssertThat(d ^ e, Equals(naive_product(d, e)));
+        });
+
+        bandit::it("threads split the rows of the product", [&]() {
+            auto a = sample<plus_times<long>>(203, 190, 6);
+            auto b = sample<plus_times<long>>(190, 170, 7);
+            auto single = multiply(a, b, 1);
+            AssertThat(multiply(a, b, 4), Equals(single));
+            AssertThat(single, Equals(naive_product(a, b)));
+        });
+
+        bandit::it("threads throw the exceptions of their rows to the caller", [&]() {
+            auto b = sample<checked_times>(190, 170, 7);
+            for (std::size_t row : {0, 202}) {
+                auto a = sample<checked_times>(203, 190, 6);
+                a(row, 5) = -1;
+                bool thrown = false;
+                try {
+                    multiply(a, b, 4);
+                } catch (const std::domain_error &) {
+                    thrown = true;
+                }
+                AssertThat(thrown, IsTrue());
+            }
+        });
+
+        bandit::it("shortest paths are powers over (min, +)", [&]() {
+            const double inf = std::numeric_limits<double>::infinity();
+            // 0 -> 1 -> 2 -> 3 is shorter than 0 -> 3.
+            matrix<min_plus<double>> w(4, 4, {0, 1, inf, 10,  //
+                                              inf, 0, 2, inf,  //
+                                              inf, inf, 0, 3,  //
+                                              inf, inf, inf, 0});
+            auto d = stimes(3, w);
+            AssertThat(d(0, 3), Equals(6.0));
+            AssertThat(d(3, 0), Equals(inf));
+            matrix<min_plus<int>> v(2, 2, {0, 5, min_plus<int>::zero(), 0});
+            auto dv = stimes(8, v);
+            AssertThat(dv(0, 1), Equals(5));
+            AssertThat(dv(1, 0), Equals(min_plus<int>::zero()));
+        });
+
+        bandit::it("the power 0 is the identity of the size of the matrix", [&]() {
+            // A single node, whose shortest paths are the power n - 1 = 0.
+            matrix<min_plus<double>> w(1, 1, {0});
+            auto shortest = stimes(0, w);
+            AssertThat(shortest.unit(), IsFalse());
+            AssertThat(shortest, Equals(matrix<min_plus<double>>::identity(1)));
+            AssertThat(shortest(0, 0), Equals(0.0));
+            AssertThat(stimes(0, matrix<real>()).unit(), IsTrue());
+            bool thrown = false;
+            try {
+                stimes(0, matrix<real>(2, 3));
+            } catch (const std::invalid_argument &) {
+                thrown = true;
+            }
+            AssertThat(thrown, IsTrue());
+        });
+
+        bandit::it("reachability is a power over (or, and)", [&]() {
+            // A cycle of 5 nodes: exactly the node 5 steps away is reached.
+            matrix<or_and> g(5, 5);
+            for (std::size_t i = 0; i < 5; ++i) {
+                g(i, (i + 1) % 5) = 1;
+            }
+            AssertThat(stimes(5, g), Equals(matrix<or_and>::identity(5)));
+            AssertThat(int(stimes(7, g)(0, 2)), Equals(1));
+        });
+
+        bandit::it("a Markov chain converges to its stationary distribution", [&]() {
+            matrix<real> p(2, 2, {0.9, 0.1, 0.5, 0.5});
+            auto q = stimes(1000, p);
+            AssertThat(std::fabs(q(0, 0) - 5.0 / 6) < 1e-9, IsTrue());
+            AssertThat(std::fabs(q(1, 1) - 1.0 / 6) < 1e-9, IsTrue());
+        });
+    });
+});
+
+int main(int argc, char *argv[]) { return bandit::run(argc, argv); }
@@ -12,6 +12,30 @@
 #include <algebra/data/monoid.hpp>
 #include "./reporter.hpp"
 
+// 2x2 matrices of integers under multiplication, counting the `mappend`s.
+struct fib_matrix {
+    unsigned long long a, b, c, d;
+
+    static int mappends;
+};
+
+int fib_matrix::mappends = 0;
+
+namespace algebra {
+    template <>
+    struct monoid<fib_matrix> {
+        static constexpr bool instance = true;
+
+        static fib_matrix mempty() { return {1, 0, 0, 1}; }
+
+        static fib_matrix mappend(const fib_matrix &x, const fib_matrix &y) {
+            ++fib_matrix::mappends;
+            return {x.a * y.a + x.b * y.c, x.a * y.b + x.b * y.d, x.c * y.a + x.d * y.c,
+                    x.c * y.b + x.d * y.d};
+        }
+    };
+};
+
 template <typename A, typename B = A>
 bool add(A const &a, A const &b) {
     return a + b == b + a + a;
@@ -79,6 +103,29 @@ go_bandit([]() {
                     },
                     100, autocheck::make_arbitrary<int, int, int>(), reporter);
         });
+
+        bandit::it("stimes of sum_monoid and prod_monoid are closed forms: ", [&]() {
+            AssertThat(int(algebra::stimes(1000000, algebra::sum(3))), Equals(3000000));
+            AssertThat(int(algebra::stimes(0, algebra::sum(3))), Equals(0));
+            AssertThat(long(algebra::stimes(40, algebra::prod(2L))), Equals(1L << 40));
+            AssertThat(int(algebra::mtimes(0, algebra::prod(7))), Equals(1));
+            AssertThat(double(algebra::stimes(10, algebra::prod(0.5))), Equals(1.0 / 1024));
+        });
+
+        bandit::it("stimes takes a logarithmic number of mappends: ", [&]() {
+            fib_matrix::mappends = 0;
+            fib_matrix f = algebra::stimes(90, fib_matrix{1, 1, 1, 0});
+            AssertThat(f.b, Equals(2880067194370816120ULL));
+            AssertThat(fib_matrix::mappends <= 2 * 7, IsTrue());
+            for (std::size_t n = 0; n < 40; ++n) {
+                fib_matrix r = algebra::stimes(n, fib_matrix{1, 1, 1, 0});
+                fib_matrix e = algebra::monoid<fib_matrix>::mempty();
+                for (std::size_t i = 0; i < n; ++i) {
+                    e = algebra::monoid<fib_matrix>::mappend(e, fib_matrix{1, 1, 1, 0});
+                }
+                AssertThat(r.a == e.a && r.b == e.b && r.c == e.c && r.d == e.d, IsTrue());
+            }
+        });
     });
 });
 
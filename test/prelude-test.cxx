@@ -0,0 +1,81 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Unit test for prelude functions.
+ */
+
+#include <bandit/bandit.h>
+#include <algebra/data/stl_container.hpp>
+#include <algebra/prelude.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+go_bandit([]() {
+    bandit::describe("Prelude test: ", [&]() {
+        bandit::it("memoize evaluates every distinct key once", [&]() {
+            using algebra::operator%;
+            int calls = 0;
+            auto f = algebra::memoize([&calls](int x) { return ++calls, x * x; });
+            auto r = f % std::vector<int>{1, 2, 1, 3, 2, 1};
+            AssertThat(r, Equals(std::vector<int>{1, 4, 1, 9, 4, 1}));
+            AssertThat(calls, Equals(3));
+            AssertThat(f.misses(), Equals(3u));
+            AssertThat(f.hits(), Equals(3u));
+        });
+
+        bandit::it("memoize can be used with bind", [&]() {
+            using algebra::operator>>=;
+            auto f = algebra::memoize([](int x) { return std::list<int>{x, -x}; });
+            auto r = std::list<int>{1, 2, 1} >>= f;
+            AssertThat(r, Equals(std::list<int>{1, -1, 2, -2, 1, -1}));
+            AssertThat(f.hits(), Equals(1u));
+        });
+
+        bandit::it("memoize keeps only the recently used entries when bounded", [&]() {
+            auto f = algebra::memoize([](int x) { return x + 1; }, 2, 1);
+            f(1), f(2), f(1), f(3), f(1);
+            AssertThat(f.size(), Equals(2u));
+            AssertThat(f.misses(), Equals(3u));
+            f(2);
+            AssertThat(f.misses(), Equals(4u));
+        });
+
+        bandit::it("memoize keeps at most its capacity over all the shards", [&]() {
+            auto one = algebra::memoize([](int x) { return x + 1; }, 1);
+            auto twenty = algebra::memoize([](int x) { return x + 1; }, 20);
+            for (int i = 0; i < 100; ++i) {
+                one(i), twenty(i);
+            }
+            AssertThat(one.size(), Equals(1u));
+            AssertThat(twenty.size() <= 20u, IsTrue());
+            AssertThat(twenty.size() > 1u, IsTrue());
+        });
+
+        bandit::it("memoize is shared between threads", [&]() {
+            std::atomic<int> calls{0};
+            auto f = algebra::memoize<int>([&calls](int x) {
+                ++calls;
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                return x;
+            });
+            std::vector<std::thread> ts;
+            for (int t = 0; t < 4; ++t) {
+                ts.emplace_back([f]() {
+                    for (int i = 0; i < 64; ++i) {
+                        f(i % 8);
+                    }
+                });
+            }
+            for (auto &t : ts) {
+                t.join();
+            }
+            AssertThat(calls.load(), Equals(8));
+            AssertThat(f.hits() + f.misses(), Equals(256u));
+        });
+    });
+});
+
+int main(int argc, char *argv[]) { return bandit::run(argc, argv); }
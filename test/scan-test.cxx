@@ -0,0 +1,153 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Unit test for scans over monoids.
+ */
+
+#include <bandit/bandit.h>
+#include <algebra/data/scan.hpp>
+#include <algebra/data/stl_container.hpp>
+#include <cstdint>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace algebra;
+
+// Unboxes the results of a scan.
+template <typename M>
+auto values(const std::vector<M> &ms) -> std::vector<decltype(ms[0].value)> {
+    std::vector<decltype(ms[0].value)> xs;
+    for (auto &m : ms) {
+        xs.push_back(m.value);
+    }
+    return xs;
+}
+
+// The running sums by a plain loop, to compare with the kernels.
+template <typename T>
+std::vector<T> running_sums(const std::vector<T> &xs) {
+    std::vector<T> sums;
+    T s = 0;
+    for (T x : xs) {
+        sums.push_back(s += x);
+    }
+    return sums;
+}
+
+go_bandit([]() {
+    bandit::describe("scan test: ", [&]() {
+        bandit::it("inclusive and exclusive scans from the left", [&]() {
+            std::vector<int> xs{3, 1, 4, 1, 5};
+            AssertThat(values(scanl1(sum<int>, xs)), Equals(std::vector<int>{3, 4, 8, 9, 14}));
+            AssertThat(values(scanl(sum<int>, xs)), Equals(std::vector<int>{0, 3, 4, 8, 9, 14}));
+            AssertThat(values(scanl1(max<int>, xs)), Equals(std::vector<int>{3, 3, 4, 4, 5}));
+            AssertThat(values(scanl1(sum<int>, std::vector<int>{})).empty(), IsTrue());
+            AssertThat(values(scanl(sum<int>, std::vector<int>{})), Equals(std::vector<int>{0}));
+        });
+
+        bandit::it("scans from the right keep the order of mappend", [&]() {
+            std::list<std::string> words{"a", "b", "c"};
+            auto id = [](const std::string &s) { return s; };
+            AssertThat(scanr1(id, words), Equals(std::vector<std::string>{"abc", "bc", "c"}));
+            AssertThat(scanr(id, words), Equals(std::vector<std::string>{"abc", "bc", "c", ""}));
+            AssertThat(scanl1(id, words), Equals(std::vector<std::string>{"a", "ab", "abc"}));
+        });
+
+        bandit::it("segmented scans restart at the flags", [&]() {
+            std::vector<int> xs{1, 2, 3, 4, 5, 6};
+            std::vector<bool> flags{true, false, true, false, false, true};
+            AssertThat(values(segmented_scanl1(sum<int>, xs, flags)),
+                       Equals(std::vector<int>{1, 3, 3, 7, 12, 6}));
+            bool thrown = false;
+            try {
+                segmented_scanl1(sum<int>, xs, std::vector<bool>{true});
+            } catch (const std::invalid_argument &) {
+                thrown = true;
+            }
+            AssertThat(thrown, IsTrue());
+        });
+
+        bandit::it("the SIMD kernels agree with plain loops, at every length", [&]() {
+            for (std::size_t n = 0; n < 40; ++n) {
+                std::vector<std::int32_t> i32;
+                std::vector<std::int64_t> i64;
+                std::vector<double> f64;
+                std::vector<float> f32;
+                for (std::size_t k = 0; k < n; ++k) {
+                    i32.push_back(std::int32_t(k * 7 % 11) - 5);
+                    i64.push_back(std::int64_t(k * 5 % 13) - 6);
+                    f64.push_back(double(k % 9) - 4.5);
+                    f32.push_back(float(k % 5) - 2.0f);
+                }
+                AssertThat(values(scanl1(sum<std::int32_t>, i32)), Equals(running_sums(i32)));
+                AssertThat(values(scanl1(sum<std::int64_t>, i64)), Equals(running_sums(i64)));
+                AssertThat(values(scanl1(sum<double>, f64)), Equals(running_sums(f64)));
+                bool sums = values(scanl1(sum<float>, f32)) == running_sums(f32);
+                AssertThat(sums, IsTrue());
+
+                std::vector<float> maxima;
+                float m = max_monoid<float>::lowest();
+                for (float x : f32) {
+                    maxima.push_back(m = x < m ? m : x);
+                }
+                AssertThat(values(scanl1(max<float>, f32)), Equals(maxima));
+            }
+            std::vector<float> negative{-3.0f, -2.0f, -5.0f, -1.0f, -4.0f};
+            AssertThat(values(scanl1(max<float>, negative)),
+                       Equals(std::vector<float>{-3.0f, -2.0f, -2.0f, -1.0f, -1.0f}));
+        });
+
+        bandit::it("parallel scans agree with the sequential ones", [&]() {
+            std::vector<std::int64_t> xs;
+            std::vector<char> flags;
+            for (std::size_t k = 0; k < 100003; ++k) {
+                xs.push_back(std::int64_t(k * 2654435761u % 1000) - 500);
+                flags.push_back(k % 997 == 0);
+            }
+            AssertThat(values(parallel_scanl1(sum<std::int64_t>, xs, 4, 1000)),
+                       Equals(values(scanl1(sum<std::int64_t>, xs))));
+            AssertThat(values(parallel_scanl(max<std::int64_t>, xs, 4, 1000)),
+                       Equals(values(scanl(max<std::int64_t>, xs))));
+            AssertThat(values(parallel_scanr(sum<std::int64_t>, xs, 3, 1000)),
+                       Equals(values(scanr(sum<std::int64_t>, xs))));
+            AssertThat(values(parallel_segmented_scanl1(sum<std::int64_t>, xs, flags, 4, 1000)),
+                       Equals(values(segmented_scanl1(sum<std::int64_t>, xs, flags))));
+
+            std::vector<std::string> words(5000, "ab");
+            auto id = [](const std::string &s) { return s; };
+            auto prefixes = parallel_scanl1(id, words, 4, 100);
+            AssertThat(prefixes.size(), Equals(words.size()));
+            AssertThat(prefixes[2999].size(), Equals(6000u));
+            bool ordered = prefixes == scanl1(id, words);
+            AssertThat(ordered, IsTrue());
+        });
+
+        bandit::it("parallel scans throw the exceptions of any chunk", [&]() {
+            std::vector<std::int64_t> xs;
+            for (std::int64_t k = 0; k < 100000; ++k) {
+                xs.push_back(k);
+            }
+            for (std::int64_t bad : {10, 99990}) {
+                auto f = [bad](std::int64_t x) {
+                    if (x == bad) {
+                        throw std::domain_error("bad value");
+                    }
+                    return sum(x);
+                };
+                bool thrown = false;
+                try {
+                    parallel_scanl1(f, xs, 4, 1000);
+                } catch (const std::domain_error &) {
+                    thrown = true;
+                }
+                AssertThat(thrown, IsTrue());
+            }
+        });
+    });
+});
+
+int main(int argc, char *argv[]) { return bandit::run(argc, argv); }
@@ -0,0 +1,228 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Unit test for small_vector.
+ */
+
+#include <bandit/bandit.h>
+#include <algebra/data/small_vector.hpp>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+template <typename T>
+using sv4 = algebra::small_vector<T, 4>;
+
+// Counts its move constructions and destructions, and declares that it can
+// be relocated without them.
+struct tracked {
+    using trivially_relocatable = std::true_type;
+
+    static int moves, destructions;
+    std::unique_ptr<int> p;
+
+    explicit tracked(int x) : p(new int(x)) {}
+    tracked(tracked &&other) noexcept : p(std::move(other.p)) { ++moves; }
+    ~tracked() { ++destructions; }
+};
+
+int tracked::moves = 0, tracked::destructions = 0;
+
+// Only holds a pointer to its resource, but doesn't declare it.
+struct opaque {
+    std::unique_ptr<int> p;
+};
+
+ALGEBRA_TRIVIALLY_RELOCATABLE(opaque)
+
+static_assert(algebra::TriviallyRelocatable<int>::value, "trivially copyable");
+static_assert(algebra::TriviallyRelocatable<std::unique_ptr<int>>::value, "unique_ptr");
+static_assert(algebra::TriviallyRelocatable<std::pair<int, std::shared_ptr<int>>>::value, "pair");
+static_assert(algebra::TriviallyRelocatable<tracked>::value, "declared by a member type");
+static_assert(algebra::TriviallyRelocatable<opaque>::value, "declared by the macro");
+static_assert(!algebra::TriviallyRelocatable<std::list<int>>::value, "not declared");
+
+// Allocates from one of several arenas, and moves with neither the vector nor
+// the elements unless told to.
+template <typename T, bool Propagate>
+struct arena_allocator {
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::integral_constant<bool, Propagate>;
+    using is_always_equal = std::false_type;
+
+    int arena;
+
+    explicit arena_allocator(int arena) : arena(arena) {}
+    template <typename U>
+    arena_allocator(const arena_allocator<U, Propagate> &other) : arena(other.arena) {}
+
+    T *allocate(std::size_t n) { return std::allocator<T>().allocate(n); }
+    void deallocate(T *p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+
+    template <typename U>
+    struct rebind {
+        using other = arena_allocator<U, Propagate>;
+    };
+
+    friend bool operator==(const arena_allocator &a, const arena_allocator &b) {
+        return a.arena == b.arena;
+    }
+    friend bool operator!=(const arena_allocator &a, const arena_allocator &b) { return !(a == b); }
+};
+
+template <bool Propagate>
+using arena_vector = algebra::small_vector<std::string, 2, arena_allocator<std::string, Propagate>>;
+
+static_assert(std::is_nothrow_move_constructible<sv4<std::string>>::value, "nothrow move");
+static_assert(std::is_nothrow_move_assignable<sv4<std::string>>::value, "nothrow move");
+static_assert(std::is_nothrow_move_constructible<sv4<opaque>>::value, "relocated");
+static_assert(std::is_nothrow_move_assignable<arena_vector<true>>::value, "propagated");
+static_assert(!std::is_nothrow_move_assignable<arena_vector<false>>::value, "may allocate");
+
+go_bandit([]() {
+    bandit::describe("small_vector test: ", [&]() {
+        bandit::it("stays inline up to its inline capacity", [&]() {
+            sv4<int> v = {1, 2, 3, 4};
+            AssertThat(v.is_inline(), IsTrue());
+            v.push_back(5);
+            AssertThat(v.is_inline(), IsFalse());
+            AssertThat(v, Equals(sv4<int>{1, 2, 3, 4, 5}));
+        });
+
+        bandit::it("moves inline and heap storage", [&]() {
+            sv4<std::string> a = {"a", "b"}, b = {"a", "b", "c", "d", "e"};
+            sv4<std::string> c = std::move(a), d = std::move(b);
+            AssertThat(c, Equals(sv4<std::string>{"a", "b"}));
+            AssertThat(d, HasLength(5));
+            AssertThat(a, IsEmpty());
+            AssertThat(b, IsEmpty());
+        });
+
+        bandit::it("moves rather than copies when a std::vector grows", [&]() {
+            std::vector<sv4<std::string>> vs;
+            for (int i = 0; i < 100; ++i) {
+                vs.push_back(sv4<std::string>{"a", "b", "c", "d", "e"});
+            }
+            const std::string *first = vs[0].data();
+            vs.reserve(vs.capacity() + 1);
+            AssertThat(vs[0].data() == first, IsTrue());
+        });
+
+        bandit::it("move assignment honors the propagation of the allocator", [&]() {
+            arena_vector<true> a(arena_allocator<std::string, true>(1));
+            arena_vector<true> b(arena_allocator<std::string, true>(2));
+            a = {"a", "b", "c"};
+            const std::string *buffer = a.data();
+            b = std::move(a);
+            AssertThat(b.get_allocator().arena, Equals(1));
+            AssertThat(b.data() == buffer, IsTrue());
+
+            arena_vector<false> c(arena_allocator<std::string, false>(1));
+            arena_vector<false> d(arena_allocator<std::string, false>(2));
+            c = {"a", "b", "c"};
+            buffer = c.data();
+            d = std::move(c);
+            AssertThat(d.get_allocator().arena, Equals(2));
+            AssertThat(d.data() == buffer, IsFalse());
+            AssertThat(d, Equals(arena_vector<false>({"a", "b", "c"},
+                                                     arena_allocator<std::string, false>(2))));
+            AssertThat(c, IsEmpty());
+        });
+
+        bandit::it("monoid::mappend(&, &)", [&]() {
+            using algebra::operator^;
+            auto s1 = sv4<int>{1, 2}, s2 = sv4<int>{3, 4};
+            AssertThat(s1 ^ s2, Equals(sv4<int>{1, 2, 3, 4}));
+            AssertThat(s1 ^ std::move(s2), Equals(sv4<int>{1, 2, 3, 4}));
+        });
+
+        bandit::it("functor::fmap(a->b, &)", [&]() {
+            using algebra::operator%;
+            auto f = [](int x) { return float(x) + 0.5f; };
+            auto r = f % sv4<int>{1, 2, 3};
+            AssertThat(r, Equals(sv4<float>{1.5f, 2.5f, 3.5f}));
+        });
+
+        bandit::it("functor::fmap(a->b, &&) reuses the storage for the same layout", [&]() {
+            using algebra::operator%;
+            sv4<std::int32_t> xs = {1, 2, 3, 4, 5, 6};
+            const void *heap = xs.data();
+            auto ys = [](std::int32_t x) { return float(x) / 2; } % std::move(xs);
+            AssertThat(static_cast<const void *>(ys.data()) == heap, IsTrue());
+            AssertThat(ys, Equals(sv4<float>{0.5f, 1.0f, 1.5f, 2.0f, 2.5f, 3.0f}));
+            AssertThat(xs, IsEmpty());
+            auto zs = [](float x) { return double(x); } % std::move(ys);
+            AssertThat(zs, Equals(sv4<double>{0.5, 1.0, 1.5, 2.0, 2.5, 3.0}));
+            auto small = [](std::int32_t x) { return float(x); } % sv4<std::int32_t>{7, 8};
+            AssertThat(small, Equals(sv4<float>{7.0f, 8.0f}));
+            AssertThat(small.is_inline(), IsTrue());
+        });
+
+        bandit::it("monad::bind with short fan-out", [&]() {
+            using algebra::operator>>=;
+            auto f = [](int x) { return sv4<int>{x, -x}; };
+            auto r = sv4<int>{1, 2} >>= f;
+            AssertThat(r, Equals(sv4<int>{1, -1, 2, -2}));
+            AssertThat(r.is_inline(), IsTrue());
+        });
+
+        bandit::it("relocates trivially relocatable elements by copying bytes", [&]() {
+            sv4<tracked> v;
+            for (int i = 0; i < 10; ++i) {
+                v.emplace_back(i);
+            }
+            AssertThat(tracked::moves, Equals(0));
+            AssertThat(tracked::destructions, Equals(0));
+            AssertThat(*v[9].p, Equals(9));
+        });
+
+        bandit::it("relocates the types declared by the macro", [&]() {
+            sv4<opaque> v;
+            for (int i = 0; i < 10; ++i) {
+                v.push_back(opaque{std::unique_ptr<int>(new int(i))});
+            }
+            AssertThat(v.is_inline(), IsFalse());
+            AssertThat(*v[0].p + *v[9].p, Equals(9));
+        });
+
+        bandit::it("splices in mappend and bind", [&]() {
+            using algebra::operator^;
+            using algebra::operator>>=;
+            sv4<std::unique_ptr<int>> a, b;
+            a.emplace_back(new int(1));
+            for (int i = 2; i < 8; ++i) {
+                b.emplace_back(new int(i));
+            }
+            const std::unique_ptr<int> *heap = b.data();
+            auto c = sv4<std::unique_ptr<int>>() ^ std::move(b);
+            AssertThat(c.data() == heap, IsTrue());
+            auto d = std::move(a) ^ std::move(c);
+            AssertThat(d, HasLength(7));
+            AssertThat(*d[6], Equals(7));
+            AssertThat(c, IsEmpty());
+            auto r = sv4<int>{1, 2, 3} >>= [](int x) {
+                sv4<std::unique_ptr<int>> xs;
+                xs.emplace_back(new int(x));
+                xs.emplace_back(new int(-x));
+                return xs;
+            };
+            AssertThat(r, HasLength(6));
+            AssertThat(*r[5], Equals(-3));
+            tracked::moves = 0;
+            auto t = sv4<int>{1, 2, 3} >>= [](int x) {
+                sv4<tracked> xs;
+                xs.emplace_back(x);
+                xs.emplace_back(-x);
+                return xs;
+            };
+            AssertThat(t, HasLength(6));
+            AssertThat(tracked::moves, Equals(0));
+        });
+    });
+});
+
+int main(int argc, char *argv[]) { return bandit::run(argc, argv); }
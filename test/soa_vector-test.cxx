@@ -0,0 +1,104 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Unit test for soa_vector.
+ */
+
+#include <bandit/bandit.h>
+#include <algebra/data/soa_vector.hpp>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+using record = std::tuple<float, float, int>;
+
+static_assert(std::is_same<std::iterator_traits<algebra::soa_vector<record>::iterator>::
+                                   iterator_category,
+                           std::random_access_iterator_tag>::value,
+              "random access");
+
+// Records with distinct fields, more than a block of the kernels.
+algebra::soa_vector<record> records(int n) {
+    algebra::soa_vector<record> v;
+    for (int i = 0; i < n; ++i) {
+        v.emplace_back(float(i), float(2 * i), 3 * i);
+    }
+    return v;
+}
+
+go_bandit([]() {
+    bandit::describe("soa_vector test: ", [&]() {
+        algebra::soa_vector<record> v = {record{1, 2, 3}, record{4, 5, 6}};
+
+        bandit::it("stores every field in its own column", [&]() {
+            AssertThat(v, HasLength(2));
+            AssertThat(v.column<2>(), Equals(std::vector<int>{3, 6}));
+        });
+
+        bandit::it("functor::fmap(projection, &) gives a plain column", [&]() {
+            using algebra::operator%;
+            auto r = algebra::project<0, 1>([](float x, float y) { return x * y; }) % v;
+            AssertThat(r, Equals(std::vector<float>{2.f, 20.f}));
+        });
+
+        bandit::it("functor::fmap(a->tuple, &) gives a soa_vector", [&]() {
+            using algebra::operator%;
+            auto r = [](const record &t) { return std::make_tuple(std::get<2>(t)); } % v;
+            AssertThat(r.column<0>(), Equals(std::vector<int>{3, 6}));
+        });
+
+        bandit::it("foldable::foldMap(projection, &)", [&]() {
+            auto s = algebra::foldMap(algebra::project<2>(algebra::sum<int>), v);
+            AssertThat(int(s), Equals(9));
+        });
+
+        bandit::it("projections of a subset of the columns, in any order", [&]() {
+            using algebra::operator%;
+            auto w = records(37);
+            auto r = algebra::project<2, 0>([](int k, float x) { return float(k) - x; }) % w;
+            std::vector<float> expected;
+            for (int i = 0; i < 37; ++i) {
+                expected.push_back(float(2 * i));
+            }
+            AssertThat(r, Equals(expected));
+            auto s = algebra::foldMap(algebra::project<1>(algebra::sum<float>), w);
+            AssertThat(float(s), Equals(36.f * 37.f));
+            auto p = algebra::parallel_foldMap(algebra::project<2>(algebra::sum<int>), w, 4, 5);
+            AssertThat(int(p), Equals(3 * 36 * 37 / 2));
+        });
+
+        bandit::it("iterates in both directions and at random", [&]() {
+            auto w = records(5);
+            std::vector<int> ks;
+            for (auto it = w.rbegin(); it != w.rend(); ++it) {
+                ks.push_back(std::get<2>(*it));
+            }
+            AssertThat(ks, Equals(std::vector<int>{12, 9, 6, 3, 0}));
+            const auto &cw = w;
+            auto first = cw.begin();
+            AssertThat(w.end() - w.begin(), Equals(5));
+            AssertThat(std::get<2>(first[3]), Equals(9));
+            AssertThat(std::get<2>(*std::next(first, 4)), Equals(12));
+            AssertThat(first < first + 1, IsTrue());
+            std::get<0>(*(w.end() - 1)) = -1.f;
+            AssertThat(w.column<0>().back(), Equals(-1.f));
+        });
+
+        bandit::it("an empty soa_vector", [&]() {
+            using algebra::operator%;
+            algebra::soa_vector<record> e;
+            AssertThat(e, IsEmpty());
+            AssertThat(e.begin() == e.end(), IsTrue());
+            AssertThat(e.rbegin() == e.rend(), IsTrue());
+            auto r = algebra::project<0, 1>([](float x, float y) { return x * y; }) % e;
+            AssertThat(r, IsEmpty());
+            auto s = algebra::foldMap(algebra::project<2>(algebra::sum<int>), e);
+            AssertThat(int(s), Equals(0));
+        });
+    });
+});
+
+int main(int argc, char *argv[]) { return bandit::run(argc, argv); }
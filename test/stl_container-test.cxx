@@ -9,6 +9,7 @@
 #include <bandit/bandit.h>
 #include <algebra/data/stl_container.hpp>
 #include <autocheck/autocheck.hpp>
+#include <functional>
 #include <iostream>
 #include "./reporter.hpp"
 
@@ -69,6 +70,91 @@ go_bandit([]() {
             auto r = f % std::list<int>{1, 2, 3, 4};
             AssertThat(r, Equals(std::list<int>{2, 3, 4, 5}));
         });
+
+        bandit::it("functor::fmap(a->a, &)", [&]() {
+            using algebra::operator%;
+            auto f = [](int x) { return x + 1; };
+            auto l = std::list<int>{1, 2, 3, 4};
+            auto r = f % l;
+            AssertThat(r, Equals(std::list<int>{2, 3, 4, 5}));
+        });
+
+        bandit::it("functor::fmap(a->b) on vector of arithmetic type", [&]() {
+            using algebra::operator%;
+            auto f = [](int x) { return float(x) + 0.5f; };
+            std::vector<int> v(37);
+            std::vector<float> expected;
+            for (int i = 0; i < 37; ++i) {
+                v[i] = i;
+                expected.push_back(float(i) + 0.5f);
+            }
+            AssertThat(f % v, Equals(expected));
+            AssertThat(f % std::move(v), Equals(expected));
+        });
+
+        bandit::it("monad::then repeats the second monad lazily", [&]() {
+            using algebra::operator>>;
+            auto r = std::list<int>{1, 2, 3} >> std::list<int>{4, 5};
+            AssertThat(r.count(), Equals(3u));
+            AssertThat(int(algebra::foldMap(algebra::sum<int>, r)), Equals(27));
+            std::list<int> l = r;
+            AssertThat(l, Equals(std::list<int>{4, 5, 4, 5, 4, 5}));
+        });
+
+        bandit::it("monoid::stimes fills one buffer of the exact size", [&]() {
+            std::string s = algebra::stimes(1000, std::string("abc"));
+            AssertThat(s.size(), Equals(3000u));
+            AssertThat(s.substr(2997), Equals("abc"));
+            auto v = algebra::stimes(5, std::vector<int>{1, 2});
+            AssertThat(v, Equals(std::vector<int>{1, 2, 1, 2, 1, 2, 1, 2, 1, 2}));
+            AssertThat(v.capacity(), Equals(10u));
+            AssertThat(algebra::stimes(0, std::list<int>{1}).empty(), IsTrue());
+            using algebra::operator>>;
+            auto r = std::vector<int>(1000000) >> std::vector<std::string>{"ab"};
+            auto all = algebra::foldMap([](const std::string &x) { return x; }, r);
+            AssertThat(all.size(), Equals(2000000u));
+        });
+
+        bandit::it("monoid::mappend(&&, &&) on deque", [&]() {
+            using algebra::operator^;
+            auto s1 = std::deque<int>{1}, s2 = std::deque<int>{2, 3, 4};
+            AssertThat(std::move(s1) ^ std::move(s2), Equals(std::deque<int>{1, 2, 3, 4}));
+        });
+
+        bandit::it("monad::bind on deque", [&]() {
+            using algebra::operator>>=;
+            auto f = [](int x) { return std::deque<int>{x, -x}; };
+            auto r = std::deque<int>{1, 2} >>= f;
+            AssertThat(r, Equals(std::deque<int>{1, -1, 2, -2}));
+        });
+
+        bandit::it("functor::fmap(a->b, &) on array", [&]() {
+            using algebra::operator%;
+            auto f = [](int x) { return float(x) + 0.5f; };
+            auto l = std::array<int, 4>{{1, 2, 3, 4}};
+            auto r = f % l;
+            AssertThat(r, Equals(std::array<float, 4>{{1.5f, 2.5f, 3.5f, 4.5f}}));
+        });
+
+        bandit::it("applicative::ap on array", [&]() {
+            using algebra::operator*;
+            auto fs = std::array<std::function<int(int)>, 2>{
+                    {[](int x) { return x - 1; }, [](int x) { return x + 1; }}};
+            using A2 = std::array<int, 2>;
+            using A3 = std::array<int, 3>;
+            auto xs = A2{{1, 2}};
+            auto ys = A2{{0, 3}};
+            auto zs = A3{{7, 7, 7}};
+            AssertThat(fs * xs, Equals(ys));
+            AssertThat(algebra::applicative<A3>::pure(7), Equals(zs));
+        });
+
+        bandit::it("foldable::foldMap on array", [&]() {
+            auto l = std::array<int, 4>{{1, 2, 3, 4}};
+            AssertThat(int(algebra::foldMap(algebra::sum<int>, l)), Equals(10));
+            AssertThat(algebra::foldr([](int x, int acc) { return x - acc; }, 0, l),
+                       Equals(-2));
+        });
     });
 });
 
@@ -0,0 +1,148 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Unit test for lazy streams and the streaming record reader.
+ */
+
+#include <bandit/bandit.h>
+#include <unistd.h>
+#include <algebra/control/stream.hpp>
+#include <algebra/data/record_reader.hpp>
+#include <algebra/data/stl_container.hpp>
+#include <cstdio>
+#include <forward_list>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace algebra;
+
+// Write `content` to a fresh temporary file, return its path.
+static std::string write_file(const std::string &content) {
+    char path[] = "/tmp/algebra-stream-XXXXXX";
+    int fd = ::mkstemp(path);
+    if (fd < 0 || ::write(fd, content.data(), content.size()) !=
+                          static_cast<ssize_t>(content.size())) {
+        throw std::runtime_error("can't write temporary file");
+    }
+    ::close(fd);
+    return path;
+}
+
+template <typename T>
+static std::vector<T> collect(const stream<T> &s) {
+    return std::vector<T>(s.begin(), s.end());
+}
+
+static std::string to_string(record r) { return std::string(r.begin(), r.end()); }
+
+go_bandit([]() {
+    bandit::describe("Stream test: ", [&]() {
+        bandit::it("functor::fmap is lazy", [&]() {
+            using algebra::operator%;
+            int calls = 0;
+            auto twice = [&calls](int x) { return ++calls, x * 2; };
+            auto s = twice % make_stream(std::vector<int>{1, 2, 3});
+            AssertThat(calls, Equals(0));
+            AssertThat(collect(s), Equals(std::vector<int>{2, 4, 6}));
+            AssertThat(calls, Equals(3));
+        });
+
+        bandit::it("monad::bind concatenates the streams", [&]() {
+            using algebra::operator>>=;
+            auto f = [](int x) { return make_stream(std::vector<int>(x, x)); };
+            auto s = make_stream(std::vector<int>{1, 0, 2, 3}) >>= f;
+            AssertThat(collect(s), Equals(std::vector<int>{1, 2, 2, 3, 3, 3}));
+            auto p = monad<stream<int>>::pure(7) >>= f;
+            AssertThat(collect(p), Equals(std::vector<int>(7, 7)));
+        });
+
+        bandit::it("foldable::foldMap consumes the stream", [&]() {
+            auto s = make_stream(std::vector<int>{1, 2, 3, 4});
+            AssertThat(foldMap([](int x) { return sum(x); }, s).value, Equals(10));
+            AssertThat(collect(s).empty(), Equals(true));
+        });
+
+        bandit::it("streams of containers without random access", [&]() {
+            std::list<int> xs;
+            for (int i = 0; i < 100000; ++i) {
+                xs.push_back(i);
+            }
+            auto s = make_stream(xs);
+            AssertThat(foldMap([](int x) { return sum<long>(x); }, s).value,
+                       Equals(100000L * 99999 / 2));
+            auto f = make_stream(std::forward_list<std::string>{"a", "b"});
+            AssertThat(collect(f), Equals(std::vector<std::string>{"a", "b"}));
+        });
+    });
+
+    bandit::describe("Record reader test: ", [&]() {
+        // Lines of various lengths crossing the chunk boundaries.
+        std::vector<std::string> expected;
+        std::string content;
+        for (int i = 0; i < 2000; ++i) {
+            expected.push_back(std::string(i % 97, char('a' + i % 26)));
+            content += expected.back() + "\n";
+        }
+        expected.push_back("no trailing line break");
+        content += expected.back();
+        std::string path = write_file(content);
+
+        bandit::it("read the lines of a file", [&]() {
+            using algebra::operator%;
+            auto ls = collect(to_string % lines(path, 4096));
+            AssertThat(ls.size(), Equals(expected.size()));
+            AssertThat(ls == expected, Equals(true));
+        });
+
+        bandit::it("read delimited records", [&]() {
+            std::string csv = write_file("a,bb,,ccc");
+            auto rs = collect(functor<stream<record>>::fmap(to_string, read_records(csv, ',')));
+            AssertThat(rs, Equals(std::vector<std::string>{"a", "bb", "", "ccc"}));
+            std::remove(csv.c_str());
+        });
+
+        bandit::it("records longer than a chunk are split", [&]() {
+            std::string big = write_file(std::string(10000, 'x') + "\nend\n");
+            std::size_t total = 0, count = 0;
+            for (auto r : lines(big, 4096)) {
+                total += r.size();
+                ++count;
+            }
+            AssertThat(total, Equals(10003u));
+            AssertThat(count > 2, Equals(true));
+            std::remove(big.c_str());
+        });
+
+        bandit::it("fold over the lines", [&]() {
+            using algebra::operator>>=;
+            auto chars = lines(path, 4096) >>= [](record r) {
+                return monad<stream<std::size_t>>::pure(r.size());
+            };
+            std::size_t n = foldMap([](std::size_t x) { return sum(x); }, chars).value;
+            AssertThat(n, Equals(content.size() - 2000));
+        });
+
+        bandit::it("empty and missing files", [&]() {
+            std::string empty = write_file("");
+            AssertThat(collect(lines(empty)).empty(), Equals(true));
+            std::remove(empty.c_str());
+            bool thrown = false;
+            try {
+                lines("/nonexistent/algebra-file");
+            } catch (const std::system_error &) {
+                thrown = true;
+            }
+            AssertThat(thrown, Equals(true));
+        });
+
+        bandit::it("remove the temporary file", [&]() {
+            AssertThat(std::remove(path.c_str()), Equals(0));
+        });
+    });
+});
+
+int main(int argc, char *argv[]) { return bandit::run(argc, argv); }
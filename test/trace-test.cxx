@@ -0,0 +1,145 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Unit test for the tracing of combinator operators.
+ */
+
+#ifndef ALGEBRA_TRACE
+#define ALGEBRA_TRACE
+#endif
+
+#include <bandit/bandit.h>
+#include <algebra/data/stl_container.hpp>
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace algebra;
+
+static std::size_t count(const std::string &s, const std::string &pattern) {
+    std::size_t n = 0;
+    for (auto pos = s.find(pattern); pos != std::string::npos; pos = s.find(pattern, pos + 1)) {
+        ++n;
+    }
+    return n;
+}
+
+static std::string flush() {
+    std::ostringstream out;
+    trace::write_json(out);
+    return out.str();
+}
+
+go_bandit([]() {
+    bandit::describe("Trace test: ", [&]() {
+        std::vector<int> xs{1, 2, 3};
+        auto inc = [](int x) { return x + 1; };
+
+        bandit::it("disabled tracing records nothing", [&]() {
+            trace::disable();
+            trace::clear();
+            auto ys = inc % xs;
+            AssertThat(ys.size(), Equals(3u));
+            AssertThat(count(flush(), "\"ph\":\"X\""), Equals(0u));
+        });
+
+        bandit::it("operators record spans", [&]() {
+            trace::enable();
+            trace::clear();
+            auto ys = inc % xs;
+            auto zs = ys ^ xs;
+            auto ws = zs >>= [](int x) { return std::vector<int>{x, x}; };
+            trace::disable();
+            std::string json = flush();
+            AssertThat(ws.size(), Equals(12u));
+            // `bind` maps with `%`, which is traced as a nested span.
+            AssertThat(count(json, "\"name\":\"fmap\""), Equals(2u));
+            AssertThat(count(json, "\"name\":\"mappend\""), Equals(1u));
+            AssertThat(count(json, "\"name\":\"bind\""), Equals(1u));
+            AssertThat(count(json, "\"input_size\":6,\"output_size\":12"), Equals(1u));
+            AssertThat(count(json, "\"input\":\"std::vector<int"), Equals(4u));
+            AssertThat(json.find("{\"traceEvents\":["), Equals(0u));
+        });
+
+        bandit::it("every thread has its own buffer", [&]() {
+            trace::enable();
+            trace::clear();
+            std::thread worker([&] {
+                for (int i = 0; i < 10; ++i) {
+                    auto ys = inc % xs;
+                }
+            });
+            worker.join();
+            auto ys = inc % xs;
+            trace::disable();
+            std::string json = flush();
+            AssertThat(count(json, "\"name\":\"fmap\""), Equals(11u));
+        });
+
+        bandit::it("full buffers keep the latest spans", [&]() {
+            trace::set_capacity(4);
+            trace::enable();
+            std::thread worker([&] {
+                for (int i = 0; i < 10; ++i) {
+                    auto ys = inc % xs;
+                }
+            });
+            worker.join();
+            trace::disable();
+            trace::set_capacity(std::size_t(1) << 16);
+            AssertThat(count(flush(), "\"name\":\"fmap\"") >= 4, Equals(true));
+            trace::clear();
+            AssertThat(count(flush(), "\"name\""), Equals(0u));
+        });
+
+        bandit::it("the buffers of exited threads are reused once flushed", [&]() {
+            trace::enable();
+            trace::clear();
+            for (int i = 0; i < 20; ++i) {
+                std::thread worker([&] { auto ys = inc % xs; });
+                worker.join();
+                AssertThat(count(flush(), "\"name\":\"fmap\""), Equals(1u));
+            }
+            trace::disable();
+            auto &g = trace::_inner_impl::global();
+            std::lock_guard<std::mutex> guard(g.lock);
+            // The buffer of this thread, and the one of all the workers.
+            AssertThat(g.rings.size() + g.free.size(), Equals(2u));
+        });
+
+        bandit::it("flush while a thread is tracing", [&]() {
+            trace::set_capacity(64);
+            trace::enable();
+            std::atomic<bool> started{false}, done{false};
+            std::thread worker([&] {
+                while (!done.load()) {
+                    auto ys = inc % xs;
+                    started = true;
+                }
+            });
+            while (!started.load()) {
+                std::this_thread::yield();
+            }
+            std::size_t spans = 0;
+            for (int i = 0; i < 100; ++i) {
+                std::string json = flush();
+                AssertThat(count(json, "{\"name\":\"fmap\""),
+                           Equals(count(json, "\"output_size\":3}}")));
+                spans += count(json, "{\"name\"");
+            }
+            done = true;
+            worker.join();
+            trace::disable();
+            trace::set_capacity(std::size_t(1) << 16);
+            trace::clear();
+            AssertThat(spans > 0, Equals(true));
+        });
+    });
+});
+
+int main(int argc, char *argv[]) { return bandit::run(argc, argv); }
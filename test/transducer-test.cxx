@@ -0,0 +1,111 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Unit test for transducers.
+ */
+
+#include <bandit/bandit.h>
+#include <algebra/control/transducer.hpp>
+#include <algebra/data/stl_container.hpp>
+#include <atomic>
+#include <list>
+#include <string>
+#include <vector>
+
+using namespace algebra;
+
+// Squares, and counts its copies.
+struct counted_square {
+    static std::atomic<int> copies;
+
+    counted_square() = default;
+    counted_square(const counted_square &) { ++copies; }
+    int operator()(int x) const { return x * x; }
+};
+
+std::atomic<int> counted_square::copies{0};
+
+go_bandit([]() {
+    bandit::describe("transducer test: ", [&]() {
+        std::vector<int> xs{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+        auto even = [](int x) { return x % 2 == 0; };
+        auto square = [](int x) { return x * x; };
+        auto to_sum = [](int x) { return sum(x); };
+
+        bandit::it("map and filter fused into foldMap", [&]() {
+            auto t = xf::filter(even) | xf::map(square);
+            AssertThat(int(foldMap(t, to_sum, xs)), Equals(4 + 16 + 36 + 64 + 100));
+        });
+
+        bandit::it("transduce with a reducing function", [&]() {
+            auto t = xf::map([](int x) { return std::to_string(x); }) | xf::take(3);
+            auto r = transduce(t, [](std::string acc, const std::string &s) { return acc + s; },
+                               std::string(), std::list<int>{7, 8, 9, 10});
+            AssertThat(r, Equals("789"));
+        });
+
+        bandit::it("take and take_while stop the traversal", [&]() {
+            int visited = 0;
+            auto count = xf::map([&visited](int x) {
+                ++visited;
+                return x;
+            });
+            AssertThat(int(foldMap(count | xf::take(3), to_sum, xs)), Equals(6));
+            AssertThat(visited, Equals(3));
+            visited = 0;
+            auto small = [](int x) { return x < 4; };
+            AssertThat(int(foldMap(count | xf::take_while(small), to_sum, xs)), Equals(6));
+            AssertThat(visited, Equals(4));
+            AssertThat(int(foldMap(xf::take(0), to_sum, xs)), Equals(0));
+        });
+
+        bandit::it("drop and dedupe", [&]() {
+            std::vector<int> ys{1, 1, 2, 2, 2, 3, 1, 1};
+            auto t = xf::dedupe() | xf::drop(1);
+            auto r = transduce(t,
+                               [](std::vector<int> acc, int x) {
+                                   acc.push_back(x);
+                                   return acc;
+                               },
+                               std::vector<int>(), ys);
+            AssertThat(r, Equals(std::vector<int>{2, 3, 1}));
+        });
+
+        bandit::it("chunk groups the elements, the last group may be shorter", [&]() {
+            auto sizes = xf::chunk(4) | xf::map([](array_view<const int> c) {
+                             return std::vector<std::size_t>{c.size()};
+                         });
+            auto r = foldMap(sizes, [](std::vector<std::size_t> v) { return v; }, xs);
+            AssertThat(r, Equals(std::vector<std::size_t>{4, 4, 2}));
+            auto sums = xf::chunk(3) | xf::map([](array_view<const int> c) {
+                            return foldMap([](int x) { return sum(x); }, c);
+                        }) | xf::take(2);
+            AssertThat(int(foldMap(sums, [](sum_monoid<int> s) { return s; }, xs)),
+                       Equals(6 + 15));
+        });
+
+        bandit::it("stateless transducers fold in parallel", [&]() {
+            std::vector<int> big(100000);
+            for (std::size_t i = 0; i < big.size(); ++i) {
+                big[i] = int(i % 100);
+            }
+            auto t = xf::filter(even) | xf::map(square);
+            auto expected = foldMap(t, to_sum, big);
+            AssertThat(int(parallel_foldMap(t, to_sum, big, 4, 1000)), Equals(int(expected)));
+        });
+
+        bandit::it("the parallel fold builds the reducer once per chunk", [&]() {
+            std::vector<int> big(100000, 2);
+            auto t = xf::filter(even) | xf::map(counted_square());
+            counted_square::copies = 0;
+            auto total = parallel_foldMap(t, to_sum, big, 4, 1000);
+            AssertThat(int(total), Equals(400000));
+            bool few = counted_square::copies < 100;
+            AssertThat(few, IsTrue());
+        });
+    });
+});
+
+int main(int argc, char *argv[]) { return bandit::run(argc, argv); }
@@ -0,0 +1,60 @@
+## Compile `SOURCE` with vectorization remarks and check that the loop of each
+## contiguous kernel, the `fmap` one in `stl_container.hpp`, the elementwise
+## one in `zip_list.hpp` and the projected `fmap` and `foldMap` in
+## `soa_vector.hpp`, was vectorized. The loops are marked by the comment
+## `// vectorized kernel`, and only the remarks on a marked line or the body
+## under it count.
+##
+## Usage: cmake -DCOMPILER=... -DCOMPILER_ID=... -DINCLUDE_DIR=... -DSOURCE=...
+##              -P vectorize-test.cmake
+
+set(kernels stl_container zip_list soa_vector)
+
+if(COMPILER_ID MATCHES "Clang")
+    set(remark_flags -Rpass=loop-vectorize|slp-vectorizer)
+    set(vectorized ":[0-9]+: remark: (vectorized loop|.*SLP vectorized)")
+elseif(COMPILER_ID STREQUAL "GNU")
+    set(remark_flags -fopt-info-vec-optimized)
+    set(vectorized ":[0-9]+: optimized: (loop|basic block).*vectorized")
+else()
+    message(STATUS "no vectorization remarks for ${COMPILER_ID}, skipped")
+    return()
+endif()
+
+execute_process(
+    COMMAND ${COMPILER} -std=c++14 -O2 -I${INCLUDE_DIR} ${remark_flags}
+            -c ${SOURCE} -o vectorize-test.o
+    RESULT_VARIABLE result
+    OUTPUT_VARIABLE output
+    ERROR_VARIABLE output)
+
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "compilation failed:\n${output}")
+endif()
+set(mark "// vectorized kernel")
+string(LENGTH "${mark}" mark_length)
+foreach(kernel ${kernels})
+    file(READ ${INCLUDE_DIR}/algebra/data/${kernel}.hpp content)
+    set(line 1)
+    set(marked 0)
+    string(FIND "${content}" "${mark}" marker)
+    while(NOT marker EQUAL -1)
+        string(SUBSTRING "${content}" 0 ${marker} before)
+        string(REGEX MATCHALL "\n" newlines "${before}")
+        list(LENGTH newlines count)
+        math(EXPR line "${line} + ${count}")
+        math(EXPR body "${line} + 1")
+        if(NOT output MATCHES "${kernel}\\.hpp:(${line}|${body})${vectorized}")
+            message(FATAL_ERROR "the kernel of ${kernel}.hpp at line ${line} wasn't vectorized:\n"
+                                "${output}")
+        endif()
+        math(EXPR marked "${marked} + 1")
+        math(EXPR marker "${marker} + ${mark_length}")
+        string(SUBSTRING "${content}" ${marker} -1 content)
+        string(FIND "${content}" "${mark}" marker)
+    endwhile()
+    if(marked EQUAL 0)
+        message(FATAL_ERROR "no kernel is marked in ${kernel}.hpp")
+    endif()
+endforeach()
+message(STATUS "the kernels were vectorized")
@@ -0,0 +1,47 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Build test for the vectorization of `fmap` over vectors of arithmetic
+ * types, of the elementwise arithmetic of `zip_list` and of the projections
+ * over the columns of `soa_vector`: `vectorize-test.cmake` compiles this file
+ * with vectorization remarks and checks that the kernels in `stl_container.hpp`,
+ * `zip_list.hpp` and `soa_vector.hpp` were vectorized.
+ */
+
+#include <algebra/data/soa_vector.hpp>
+#include <algebra/data/stl_container.hpp>
+#include <algebra/data/zip_list.hpp>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+using namespace algebra;
+
+std::vector<float> affine(const std::vector<float> &xs) {
+    return functor<std::vector<float>>::fmap([](float x) { return 2.0f * x + 1.0f; }, xs);
+}
+
+std::vector<float> to_float(std::vector<std::int32_t> &&xs) {
+    return functor<std::vector<std::int32_t>>::fmap([](std::int32_t x) { return float(x); },
+                                                   std::move(xs));
+}
+
+std::vector<double> halve(const std::vector<double> &xs) {
+    return functor<std::vector<double>>::fmap([](double x) { return x / 2; }, xs);
+}
+
+zip_list<float> axpy(const zip_list<float> &a, const zip_list<float> &x, const zip_list<float> &y) {
+    return fma(a, x, y);
+}
+
+using particles = soa_vector<std::tuple<float, float, std::int32_t>>;
+
+std::vector<float> areas(const particles &v) {
+    return functor<particles>::fmap(project<0, 1>([](float x, float y) { return x * y; }), v);
+}
+
+sum_monoid<std::int32_t> total(const particles &v) {
+    return foldable<particles>::foldMap(project<2>([](std::int32_t k) { return sum(k); }), v);
+}
@@ -0,0 +1,69 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Unit test for writer monad.
+ */
+
+#include <bandit/bandit.h>
+#include <algebra/control/writer.hpp>
+#include <functional>
+#include <string>
+
+using log_writer = algebra::writer<std::string, int>;
+
+go_bandit([]() {
+    bandit::describe("Writer test: ", [&]() {
+        auto step = [](int x) { return log_writer(x + 1, "inc;"); };
+
+        bandit::it("monad::bind combines the logs in order", [&]() {
+            using algebra::operator>>=;
+            auto w = (log_writer(0, "start;") >>= step) >>= step;
+            AssertThat(w.value(), Equals(2));
+            AssertThat(w.log(), Equals("start;inc;inc;"));
+        });
+
+        bandit::it("monad::pure has an empty log", [&]() {
+            using algebra::operator>>=;
+            auto w = algebra::monad<log_writer>::pure(1) >>= step;
+            AssertThat(w, Equals(log_writer(2, "inc;")));
+        });
+
+        bandit::it("functor::fmap keeps the log", [&]() {
+            using algebra::operator%;
+            auto w = [](int x) { return x * 10; } % log_writer(1, "one;");
+            AssertThat(w, Equals(log_writer(10, "one;")));
+        });
+
+        bandit::it("applicative::ap applies the function and logs it first", [&]() {
+            using algebra::operator*;
+            using fn_writer = algebra::writer<std::string, std::function<int(int)>>;
+            auto f = fn_writer([](int x) { return x * 2; }, "f;");
+            auto w = f * log_writer(21, "a;");
+            AssertThat(w.value(), Equals(42));
+            AssertThat(w.log(), Equals("f;a;"));
+
+            auto p = algebra::applicative<fn_writer>::pure([](int x) { return x + 1; });
+            auto v = algebra::applicative<log_writer>::ap(p, log_writer(1, "b;"));
+            AssertThat(v, Equals(log_writer(2, "b;")));
+        });
+
+        bandit::it("tell and then", [&]() {
+            using algebra::operator>>;
+            auto w = algebra::tell(std::string("a")) >> algebra::tell(std::string("b"));
+            AssertThat(w.log(), Equals("ab"));
+        });
+
+        bandit::it("numeric monoid as log", [&]() {
+            using algebra::operator>>=;
+            using counter = algebra::writer<algebra::sum_monoid<int>, int>;
+            auto f = [](int x) { return counter(x * 2, algebra::sum(1)); };
+            auto w = (counter(1) >>= f) >>= f;
+            AssertThat(w.value(), Equals(4));
+            AssertThat(int(w.log()), Equals(2));
+        });
+    });
+});
+
+int main(int argc, char *argv[]) { return bandit::run(argc, argv); }
@@ -0,0 +1,86 @@
+/**
+ * The MIT License(MIT). Copyright (c) 2016 He Tao
+ */
+
+/**
+ * Unit test for zip_list.
+ */
+
+#include <bandit/bandit.h>
+#include <algebra/data/zip_list.hpp>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace algebra;
+
+go_bandit([]() {
+    bandit::describe("zip_list test: ", [&]() {
+        bandit::it("fmap maps every element", [&]() {
+            zip_list<int> xs{1, 2, 3};
+            auto ys = [](int x) { return x * 2; } % xs;
+            AssertThat(ys, Equals(zip_list<int>{2, 4, 6}));
+            auto r = [](int x) { return std::to_string(x); } % zip_list<int>::repeat(7);
+            AssertThat(r.infinite(), IsTrue());
+            AssertThat(r[100], Equals("7"));
+        });
+
+        bandit::it("ap applies the functions elementwise", [&]() {
+            zip_list<std::function<int(int)>> fs{[](int x) { return x + 1; },
+                                                 [](int x) { return x * 10; }};
+            auto r = fs * zip_list<int>{1, 2, 3};
+            AssertThat(r, Equals(zip_list<int>{2, 20}));
+            auto same = applicative<zip_list<std::function<int(int)>>>::pure(
+                                [](int x) { return x; }) *
+                        zip_list<int>{4, 5};
+            AssertThat(same, Equals(zip_list<int>{4, 5}));
+        });
+
+        bandit::it("liftA2 pairs the i-th elements, up to the shortest list", [&]() {
+            zip_list<std::string> names{"a", "b", "c"};
+            zip_list<int> counts{1, 2};
+            auto r = liftA2([](const std::string &s, int n) { return s + std::to_string(n); },
+                            names, counts);
+            AssertThat(r, Equals(zip_list<std::string>{"a1", "b2"}));
+            auto p = liftA2(std::plus<int>(), zip_list<int>::repeat(1), zip_list<int>::repeat(2));
+            AssertThat(p, Equals(zip_list<int>::repeat(3)));
+        });
+
+        bandit::it("arithmetic kernels over long columns", [&]() {
+            std::vector<float> a(1000), b(1000), c(1000);
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                a[i] = float(i);
+                b[i] = float(i % 7) + 1;
+                c[i] = 0.5f;
+            }
+            zip_list<float> xs(a), ys(b), zs(c);
+            auto sum = xs + ys, diff = xs - ys, prod = xs * ys, quot = xs / ys;
+            auto fused = fma(xs, ys, zs);
+            auto scaled = xs * applicative<zip_list<float>>::pure(2.0f);
+            bool ok = sum.size() == 1000 && fused.size() == 1000 && !fused.infinite();
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                ok = ok && sum[i] == a[i] + b[i] && diff[i] == a[i] - b[i] &&
+                     prod[i] == a[i] * b[i] && quot[i] == a[i] / b[i] &&
+                     std::fabs(fused[i] - (a[i] * b[i] + 0.5f)) <= 1e-3f &&
+                     scaled[i] == 2 * a[i];
+            }
+            AssertThat(ok, IsTrue());
+        });
+
+        bandit::it("combines into a result of the exact size", [&]() {
+            zip_list<double> xs(std::vector<double>(100, 1.5)), ys(std::vector<double>(60, 2.0));
+            auto r = fma(xs, ys, zip_list<double>::repeat(1.0));
+            AssertThat(r.size(), Equals(60u));
+            AssertThat(r.get().capacity(), Equals(60u));
+            AssertThat(r[59], Equals(4.0));
+        });
+
+        bandit::it("folds the elements", [&]() {
+            auto total = foldMap([](int x) { return sum(x); }, zip_list<int>{1, 2, 3, 4});
+            AssertThat(int(total), Equals(10));
+        });
+    });
+});
+
+int main(int argc, char *argv[]) { return bandit::run(argc, argv); }